@@ -0,0 +1,201 @@
+/**
+ * @file Bench.h
+ * @brief Minimal benchmark harness: batch timing, percentiles, allocation counts, JSON output
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace revak::bench {
+
+/**
+ * @brief Allocations made by every thread since start
+ *
+ * Incremented by the global operator new replaced with
+ * REVAK_BENCH_COUNT_ALLOCATIONS() in the benchmark's main file.
+ */
+inline std::atomic<uint64_t> allocation_count{0};
+
+/** Keep the compiler from optimizing a computed value away */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @class Suite
+ * @brief Runs benchmark cases and reports them as a table or as JSON
+ *
+ * A case is a function running a given number of operations. It is run
+ * once to warm up, then for a number of samples; each sample is timed as a
+ * whole and divided by its operation count, so the percentiles describe
+ * the spread between batches rather than single operations (too short to
+ * time one by one). Allocations are counted across all threads.
+ *
+ * Command line: [--json] [--samples N] [--filter SUBSTRING]
+ */
+class Suite {
+public:
+  Suite(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+      std::string_view arg = argv[i];
+      if (arg == "--json") {
+        json_ = true;
+      } else if (arg == "--samples" && i + 1 < argc) {
+        samples_ = std::max(1, std::atoi(argv[++i]));
+      } else if (arg == "--filter" && i + 1 < argc) {
+        filter_ = argv[++i];
+      } else {
+        std::fprintf(stderr, "usage: %s [--json] [--samples N] [--filter SUBSTRING]\n", argv[0]);
+        std::exit(2);
+      }
+    }
+
+    // Results go to the original stdout; whatever the code under test prints is discarded
+    out_ = ::fdopen(::dup(STDOUT_FILENO), "w");
+    std::fflush(stdout);
+    if (FILE* null = std::fopen("/dev/null", "w")) {
+      ::dup2(::fileno(null), STDOUT_FILENO);
+      std::fclose(null);
+    }
+
+    if (json_) {
+      std::fprintf(out_, "{\n  \"context\": {\"cpus\": %u, \"samples\": %d},\n  \"benchmarks\": [",
+                   std::thread::hardware_concurrency(), samples_);
+    } else {
+      std::fprintf(out_, "%-36s %12s %10s %10s %10s %12s %10s\n", "benchmark", "ns/op", "p50", "p90", "p99", "allocs/op",
+                   "MB/s");
+    }
+  }
+
+  ~Suite() {
+    if (json_) {
+      std::fprintf(out_, "\n  ]\n}\n");
+    }
+    std::fclose(out_);
+  }
+
+  Suite(const Suite&) = delete;
+  Suite& operator=(const Suite&) = delete;
+
+  /**
+   * @brief Run and report one case
+   * @param name Case name, "group/variant"
+   * @param ops_per_sample Operations run by each call of the body
+   * @param body Callable taking the number of operations to run
+   * @param bytes_per_op Bytes each operation processes, reported as throughput if not 0
+   */
+  template <typename Body>
+  void Run(std::string_view name, size_t ops_per_sample, Body&& body, size_t bytes_per_op = 0) {
+    if (!filter_.empty() && name.find(filter_) == std::string_view::npos) {
+      return;
+    }
+
+    body(ops_per_sample); // Warm-up: caches, lazy initialization, pool threads
+
+    std::vector<double> ns_per_op;
+    ns_per_op.reserve(static_cast<size_t>(samples_));
+    uint64_t allocations = 0;
+    for (int i = 0; i < samples_; ++i) {
+      uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+      auto start = std::chrono::steady_clock::now();
+      body(ops_per_sample);
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      allocations += allocation_count.load(std::memory_order_relaxed) - allocations_before;
+      ns_per_op.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ops_per_sample));
+    }
+
+    double total_ops = static_cast<double>(ops_per_sample) * samples_;
+    double mean = 0;
+    for (double value : ns_per_op) {
+      mean += value;
+    }
+    mean /= samples_;
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+    Report(name, mean, Percentile(ns_per_op, 0.5), Percentile(ns_per_op, 0.9), Percentile(ns_per_op, 0.99),
+           ns_per_op.front(), static_cast<double>(allocations) / total_ops,
+           bytes_per_op > 0 ? static_cast<double>(bytes_per_op) * 1e3 / mean : 0);
+  }
+
+private:
+  static double Percentile(const std::vector<double>& sorted, double fraction) {
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+  }
+
+  /** Throughput is in MB/s (10^6 bytes), 0 when the case gave no byte count */
+  void Report(std::string_view name, double mean, double p50, double p90, double p99, double min, double allocs,
+              double throughput) {
+    if (json_) {
+      std::fprintf(out_, "%s\n    {\"name\": \"%.*s\", \"ns_per_op\": %.2f, \"min\": %.2f, \"p50\": %.2f, "
+                   "\"p90\": %.2f, \"p99\": %.2f, \"allocs_per_op\": %.3f",
+                   first_ ? "" : ",", static_cast<int>(name.size()), name.data(), mean, min, p50, p90, p99, allocs);
+      if (throughput > 0) {
+        std::fprintf(out_, ", \"mb_per_s\": %.1f", throughput);
+      }
+      std::fprintf(out_, "}");
+    } else if (throughput > 0) {
+      std::fprintf(out_, "%-36.*s %12.1f %10.1f %10.1f %10.1f %12.3f %10.1f\n",
+                   static_cast<int>(name.size()), name.data(), mean, p50, p90, p99, allocs, throughput);
+    } else {
+      std::fprintf(out_, "%-36.*s %12.1f %10.1f %10.1f %10.1f %12.3f %10s\n",
+                   static_cast<int>(name.size()), name.data(), mean, p50, p90, p99, allocs, "-");
+    }
+    std::fflush(out_);
+    first_ = false;
+  }
+
+  /** Output for the results, stdout before it was redirected */
+  FILE* out_{nullptr};
+
+  bool json_{false};
+  bool first_{true};
+  int samples_{30};
+  std::string filter_;
+};
+
+} // namespace revak::bench
+
+/**
+ * Replace the global allocation functions with counting ones; use once,
+ * at namespace scope, in the benchmark's main file.
+ */
+#define REVAK_BENCH_COUNT_ALLOCATIONS()                                                \
+  /* Out of line: GCC warns when it sees an inlined malloc() freed by operator delete */ \
+  [[gnu::noinline]] void* operator new(std::size_t size) {                             \
+    ::revak::bench::allocation_count.fetch_add(1, std::memory_order_relaxed);          \
+    if (void* p = std::malloc(size ? size : 1)) return p;                              \
+    throw std::bad_alloc();                                                            \
+  }                                                                                    \
+  void* operator new[](std::size_t size) { return ::operator new(size); }              \
+  [[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }           \
+  [[gnu::noinline]] void operator delete[](void* p) noexcept { std::free(p); }         \
+  [[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); } \
+  [[gnu::noinline]] void operator delete[](void* p, std::size_t) noexcept { std::free(p); } \
+  [[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t align) {     \
+    ::revak::bench::allocation_count.fetch_add(1, std::memory_order_relaxed);          \
+    std::size_t alignment = static_cast<std::size_t>(align);                           \
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) return p; \
+    throw std::bad_alloc();                                                            \
+  }                                                                                    \
+  void* operator new[](std::size_t size, std::align_val_t align) { return ::operator new(size, align); } \
+  void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }           \
+  void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }         \
+  void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); } \
+  void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
@@ -0,0 +1,177 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief HDR-style log-linear latency histogram
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace revak::bench {
+
+/**
+ * @class LatencyHistogram
+ * @brief Records values with three significant digits over the whole uint64 range
+ *
+ * Same layout as an HdrHistogram: values below 2048 are counted exactly,
+ * every power of two above is split into 1024 linear sub-buckets, so any
+ * recorded value is known to within 1/1024 of itself. Recording is a shift
+ * and an increment; histograms of several threads are merged afterwards.
+ */
+class LatencyHistogram {
+public:
+  LatencyHistogram() : counts_(kBuckets, 0) {}
+
+  /** @brief Count one value */
+  void Record(uint64_t value) {
+    ++counts_[Index(value)];
+    ++total_;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    double v = static_cast<double>(value);
+    sum_ += v;
+    sum_squares_ += v * v;
+  }
+
+  /** @brief Add every count of another histogram */
+  void Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+    sum_squares_ += other.sum_squares_;
+  }
+
+  uint64_t TotalCount() const { return total_; }
+  uint64_t Min() const { return total_ == 0 ? 0 : min_; }
+  uint64_t Max() const { return max_; }
+  double Mean() const { return total_ == 0 ? 0 : sum_ / static_cast<double>(total_); }
+
+  double StdDeviation() const {
+    if (total_ == 0) {
+      return 0;
+    }
+    double mean = Mean();
+    return std::sqrt(std::max(0.0, sum_squares_ / static_cast<double>(total_) - mean * mean));
+  }
+
+  /**
+   * @brief Smallest recorded value at or above a percentile of the counts
+   * @param percentile 0 to 100
+   * @return Highest value equivalent to the bucket reached, capped at Max()
+   */
+  uint64_t ValueAtPercentile(double percentile) const {
+    if (total_ == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::min(percentile, 100.0) / 100.0 * static_cast<double>(total_)));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += counts_[i];
+      if (seen >= target) {
+        return std::min(HighestEquivalent(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  /**
+   * @brief Print the percentile distribution in HdrHistogram's text format
+   *
+   * The output can be fed to HdrHistogram's plotter as is. Reporting steps
+   * halve the distance to 100% every five lines, so the tail gets as many
+   * lines as the body.
+   * @param out Destination
+   * @param scale Divisor applied to every value (e.g. 1000 to print ns as us)
+   */
+  void PrintPercentiles(FILE* out, double scale) const {
+    std::fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (total_ == 0) {
+      return;
+    }
+
+    constexpr int kTicksPerHalfDistance = 5;
+    double percentile = 0;
+    while (true) {
+      uint64_t value = ValueAtPercentile(percentile);
+      uint64_t count = CountAtOrBelow(value);
+      double fraction = static_cast<double>(count) / static_cast<double>(total_);
+      if (count == total_) {
+        std::fprintf(out, "%12.3f %14.12f %10llu %14s\n", static_cast<double>(value) / scale, 1.0,
+                     static_cast<unsigned long long>(count), "inf");
+        break;
+      }
+      std::fprintf(out, "%12.3f %14.12f %10llu %14.2f\n", static_cast<double>(value) / scale, fraction,
+                   static_cast<unsigned long long>(count), 1.0 / (1.0 - fraction));
+
+      double half_distance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1);
+      percentile += 100.0 / (kTicksPerHalfDistance * half_distance);
+    }
+
+    std::fprintf(out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", Mean() / scale, StdDeviation() / scale);
+    std::fprintf(out, "#[Max     = %12.3f, Total count    = %12llu]\n", static_cast<double>(max_) / scale,
+                 static_cast<unsigned long long>(total_));
+    std::fprintf(out, "#[Buckets = %12zu, SubBuckets     = %12zu]\n", kShifts + 1, kSubBuckets);
+  }
+
+private:
+  /** Exactly counted values, also the sub-bucket count of the first power-of-two range */
+  static constexpr size_t kSubBuckets = 2048;
+  static constexpr size_t kHalfSubBuckets = kSubBuckets / 2;
+
+  /** Powers of two above the exact range: shift 1 covers [2048, 4096), shift 53 reaches 2^64 */
+  static constexpr size_t kShifts = 53;
+  static constexpr size_t kBuckets = kSubBuckets + kShifts * kHalfSubBuckets;
+
+  static size_t Index(uint64_t value) {
+    if (value < kSubBuckets) {
+      return static_cast<size_t>(value);
+    }
+    // Shift that brings the value into [1024, 2048)
+    size_t shift = static_cast<size_t>(std::bit_width(value)) - 11;
+    return kSubBuckets + (shift - 1) * kHalfSubBuckets + static_cast<size_t>((value >> shift) - kHalfSubBuckets);
+  }
+
+  static uint64_t HighestEquivalent(size_t index) {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    size_t shift = (index - kSubBuckets) / kHalfSubBuckets + 1;
+    uint64_t sub_bucket = (index - kSubBuckets) % kHalfSubBuckets + kHalfSubBuckets;
+    if (shift >= 53) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+  uint64_t CountAtOrBelow(uint64_t value) const {
+    uint64_t seen = 0;
+    size_t last = Index(value);
+    for (size_t i = 0; i <= last; ++i) {
+      seen += counts_[i];
+    }
+    return seen;
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t total_{0};
+  uint64_t min_{std::numeric_limits<uint64_t>::max()};
+  uint64_t max_{0};
+  double sum_{0};
+  double sum_squares_{0};
+};
+
+} // namespace revak::bench
@@ -0,0 +1,73 @@
+/**
+ * @file LegacyThreadPool.h
+ * @brief The original mutex and condition variable thread pool, kept as a benchmark baseline
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace revak::bench {
+
+/**
+ * @class LegacyThreadPool
+ * @brief Single shared queue guarded by one mutex
+ */
+class LegacyThreadPool {
+public:
+  explicit LegacyThreadPool(size_t numThreads) : stop_(false) {
+    for (size_t i = 0; i < numThreads; i++) {
+      workers_.emplace_back([this] {
+        while (true) {
+          std::function<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty()) {
+              return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+          }
+          task();
+        }
+      });
+    }
+  }
+
+  ~LegacyThreadPool() {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& w : workers_) {
+      w.join();
+    }
+  }
+
+  void Enqueue(std::function<void()> task) {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      tasks_.push(std::move(task));
+    }
+    condition_.notify_one();
+  }
+
+private:
+  std::vector<std::thread> workers_;
+  std::mutex queue_mutex_;
+  bool stop_;
+  std::queue<std::function<void()>> tasks_;
+  std::condition_variable condition_;
+};
+
+} // namespace revak::bench
@@ -0,0 +1,585 @@
+/**
+ * @file LoadGen.cc
+ * @brief revak_loadgen: closed- and open-loop HTTP/1.1 load generator
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <revak/Socket.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using revak::bench::LatencyHistogram;
+
+/** Command-line settings */
+struct Options {
+  std::string host{"127.0.0.1"};
+  uint16_t port{8080};
+  std::string path{"/hello"};
+  size_t connections{16};
+  size_t threads{2};
+  double duration{10};
+
+  /** Requests per second over all connections; 0 runs closed-loop */
+  double rate{0};
+
+  /** Requests written ahead of their responses on each connection */
+  size_t pipeline{1};
+
+  bool keep_alive{true};
+};
+
+/** Monotonic time in nanoseconds */
+int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+    return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+  });
+}
+
+/** Outcome of framing the response at the start of a buffer */
+enum class Framing {
+  INCOMPLETE,  ///< More bytes are needed
+  COMPLETE,    ///< A whole response of the reported size is buffered
+  UNTIL_CLOSE, ///< The body has no length and ends when the server closes
+  INVALID      ///< Not an HTTP/1.x response
+};
+
+/**
+ * @brief Find where the first response in a buffer ends
+ *
+ * Only frames the message (Content-Length, chunked or close-delimited
+ * bodies); the body itself is skipped.
+ * @param data Received bytes, starting at a response
+ * @param size Set to the response size when COMPLETE
+ * @param status Set to the status code once the head is complete
+ * @param close Set if the server announced it closes the connection
+ */
+Framing FrameResponse(std::string_view data, size_t& size, int& status, bool& close) {
+  size_t head_end = data.find("\r\n\r\n");
+  if (head_end == std::string_view::npos) {
+    return data.size() > 65536 ? Framing::INVALID : Framing::INCOMPLETE;
+  }
+  if (data.size() < 12 || !data.starts_with("HTTP/1.")) {
+    return Framing::INVALID;
+  }
+  status = std::atoi(std::string(data.substr(9, 3)).c_str());
+
+  std::string_view head = data.substr(0, head_end);
+  size_t body_start = head_end + 4;
+  size_t content_length = 0;
+  bool has_length = false;
+  bool chunked = false;
+  close = false;
+
+  size_t line_start = head.find("\r\n") + 2;
+  while (line_start < head.size()) {
+    size_t line_end = head.find("\r\n", line_start);
+    std::string_view line = head.substr(line_start, line_end == std::string_view::npos ? std::string_view::npos : line_end - line_start);
+    size_t colon = line.find(':');
+    if (colon != std::string_view::npos) {
+      std::string_view name = line.substr(0, colon);
+      std::string_view value = line.substr(colon + 1);
+      while (!value.empty() && value.front() == ' ') {
+        value.remove_prefix(1);
+      }
+      if (EqualsIgnoreCase(name, "Content-Length")) {
+        content_length = std::strtoull(std::string(value).c_str(), nullptr, 10);
+        has_length = true;
+      } else if (EqualsIgnoreCase(name, "Transfer-Encoding")) {
+        chunked = value.find("chunked") != std::string_view::npos;
+      } else if (EqualsIgnoreCase(name, "Connection")) {
+        close = EqualsIgnoreCase(value, "close");
+      }
+    }
+    if (line_end == std::string_view::npos) {
+      break;
+    }
+    line_start = line_end + 2;
+  }
+
+  if ((status >= 100 && status < 200) || status == 204 || status == 304) {
+    size = body_start;
+    return Framing::COMPLETE;
+  }
+
+  if (chunked) {
+    size_t position = body_start;
+    while (true) {
+      size_t line_end = data.find("\r\n", position);
+      if (line_end == std::string_view::npos) {
+        return Framing::INCOMPLETE;
+      }
+      size_t chunk_size = std::strtoull(std::string(data.substr(position, line_end - position)).c_str(), nullptr, 16);
+      position = line_end + 2;
+      if (chunk_size == 0) {
+        // Optional trailer fields, then the empty line
+        size_t trailer_end = data.substr(position).starts_with("\r\n") ? position : data.find("\r\n\r\n", position);
+        if (trailer_end == std::string_view::npos || data.size() < trailer_end + 2) {
+          return Framing::INCOMPLETE;
+        }
+        size = trailer_end + (trailer_end == position ? 2 : 4);
+        return Framing::COMPLETE;
+      }
+      position += chunk_size + 2;
+      if (position > data.size()) {
+        return Framing::INCOMPLETE;
+      }
+    }
+  }
+
+  if (has_length) {
+    if (data.size() < body_start + content_length) {
+      return Framing::INCOMPLETE;
+    }
+    size = body_start + content_length;
+    return Framing::COMPLETE;
+  }
+  return Framing::UNTIL_CLOSE;
+}
+
+/** Totals of one worker thread, merged at the end */
+struct Results {
+  LatencyHistogram latency;
+  uint64_t responses{0};
+  uint64_t non_2xx{0};
+  uint64_t bytes_read{0};
+  uint64_t connect_errors{0};
+  uint64_t read_errors{0};
+  uint64_t reconnects{0};
+};
+
+/**
+ * @class Worker
+ * @brief Drives a share of the connections from one thread with its own epoll
+ *
+ * Closed-loop, a connection keeps `pipeline` requests outstanding and a
+ * latency is measured from the moment its request is written. Open-loop,
+ * each connection follows a fixed schedule of rate / connections requests
+ * per second; a request that is due while the connection is still waiting
+ * (its pipeline is full) stays queued, and its latency is measured from
+ * the time it was due, not from when it could be written, so a stalled
+ * server shows up as queueing delay instead of being hidden (coordinated
+ * omission).
+ */
+class Worker {
+public:
+  Worker(const Options& options, size_t connections, size_t first_connection) : options_(options) {
+    request_ = "GET " + options.path + " HTTP/1.1\r\nHost: " + options.host + ":" + std::to_string(options.port) +
+               "\r\nUser-Agent: revak_loadgen\r\n" + (options.keep_alive ? "" : "Connection: close\r\n") + "\r\n";
+    connections_.resize(connections);
+
+    if (options.rate > 0) {
+      // Stagger the connections so their schedules do not fire together
+      interval_ = static_cast<int64_t>(1e9 * static_cast<double>(options.connections) / options.rate);
+      for (size_t i = 0; i < connections; ++i) {
+        connections_[i].phase = interval_ * static_cast<int64_t>(first_connection + i) / static_cast<int64_t>(options.connections);
+      }
+    }
+  }
+
+  Worker(const Worker&) = delete;
+  Worker& operator=(const Worker&) = delete;
+
+  ~Worker() {
+    if (epoll_fd_ >= 0) {
+      ::close(epoll_fd_);
+    }
+  }
+
+  /**
+   * @brief Connect every connection
+   * @return false if none could connect
+   */
+  bool Connect() {
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    size_t connected = 0;
+    for (ClientConnection& connection : connections_) {
+      connected += Open(connection) ? 1 : 0;
+    }
+    return connected > 0;
+  }
+
+  /** Run until the deadline (monotonic ns); start is when the first request of every schedule is due */
+  void Run(int64_t start, int64_t deadline) {
+    for (ClientConnection& connection : connections_) {
+      connection.next_due = start + connection.phase;
+      Pump(connection, start);
+    }
+
+    std::vector<epoll_event> events(64);
+    while (true) {
+      int64_t now = Now();
+      if (now >= deadline) {
+        break;
+      }
+      int64_t wake = deadline;
+      if (interval_ > 0) {
+        for (const ClientConnection& connection : connections_) {
+          if (connection.socket.NativeHandle() >= 0 && connection.in_flight.size() < options_.pipeline) {
+            wake = std::min(wake, connection.next_due);
+          }
+        }
+      }
+      // Nanosecond timeout: waking a millisecond late would add the generator's own delay to the latencies
+      int64_t wait = std::max<int64_t>(0, wake - now);
+      timespec timeout{static_cast<time_t>(wait / 1'000'000'000), static_cast<long>(wait % 1'000'000'000)};
+
+      int ready = ::epoll_pwait2(epoll_fd_, events.data(), static_cast<int>(events.size()), &timeout, nullptr);
+      if (ready < 0 && errno != EINTR) {
+        std::perror("epoll_pwait2");
+        break;
+      }
+      now = Now();
+      for (int i = 0; i < ready; ++i) {
+        ClientConnection& connection = connections_[events[i].data.u64];
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+          Receive(connection, now);
+        }
+        if ((events[i].events & EPOLLOUT) && connection.socket.NativeHandle() >= 0) {
+          Flush(connection);
+        }
+      }
+      if (interval_ > 0) {
+        for (ClientConnection& connection : connections_) {
+          Pump(connection, now);
+        }
+      }
+    }
+  }
+
+  const Results& GetResults() const { return results_; }
+
+private:
+  struct ClientConnection {
+    revak::Socket socket{revak::Socket::FromNativeHandle(-1)};
+
+    /** Received bytes not yet framed into responses */
+    std::string input;
+
+    /** Written requests not yet accepted by the kernel */
+    std::string output;
+    size_t output_sent{0};
+
+    /** Start times of the requests written and not answered, oldest first */
+    std::deque<int64_t> in_flight;
+
+    /** Open-loop: offset of the schedule and time the next request is due */
+    int64_t phase{0};
+    int64_t next_due{0};
+  };
+
+  bool Open(ClientConnection& connection) {
+    connection.socket = revak::Socket();
+    if (!connection.socket.Connect(options_.host, options_.port) || !connection.socket.SetNoDelay() ||
+        !connection.socket.SetNonBlocking()) {
+      ++results_.connect_errors;
+      connection.socket.Close();
+      return false;
+    }
+    connection.input.clear();
+    connection.output.clear();
+    connection.output_sent = 0;
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLET | EPOLLRDHUP;
+    event.data.u64 = static_cast<uint64_t>(&connection - connections_.data());
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, connection.socket.NativeHandle(), &event);
+    return true;
+  }
+
+  /** Reconnect after the server closed, writing again what it left unanswered */
+  void Reopen(ClientConnection& connection) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection.socket.NativeHandle(), nullptr);
+    if (!Open(connection)) {
+      connection.in_flight.clear();
+      return;
+    }
+    ++results_.reconnects;
+    for (size_t i = 0; i < connection.in_flight.size(); ++i) {
+      connection.output += request_;
+    }
+    Flush(connection);
+  }
+
+  /** Write the requests that are due (open-loop) or fill the pipeline (closed-loop) */
+  void Pump(ClientConnection& connection, int64_t now) {
+    if (connection.socket.NativeHandle() < 0) {
+      return;
+    }
+    size_t depth = options_.keep_alive ? options_.pipeline : 1;
+    bool wrote = false;
+    while (connection.in_flight.size() < depth) {
+      if (interval_ > 0) {
+        if (connection.next_due > now) {
+          break;
+        }
+        connection.in_flight.push_back(connection.next_due);
+        connection.next_due += interval_;
+      } else {
+        connection.in_flight.push_back(now);
+      }
+      connection.output += request_;
+      wrote = true;
+    }
+    if (wrote) {
+      Flush(connection);
+    }
+  }
+
+  void Flush(ClientConnection& connection) {
+    while (connection.output_sent < connection.output.size()) {
+      ssize_t sent = ::send(connection.socket.NativeHandle(), connection.output.data() + connection.output_sent,
+                            connection.output.size() - connection.output_sent, MSG_NOSIGNAL);
+      if (sent < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          ++results_.read_errors;
+          Reopen(connection);
+        }
+        return; // The rest goes out on EPOLLOUT
+      }
+      connection.output_sent += static_cast<size_t>(sent);
+    }
+    connection.output.clear();
+    connection.output_sent = 0;
+  }
+
+  void Receive(ClientConnection& connection, int64_t now) {
+    char buffer[16384];
+    bool closed = false;
+    while (true) {
+      ssize_t received = ::recv(connection.socket.NativeHandle(), buffer, sizeof(buffer), 0);
+      if (received > 0) {
+        connection.input.append(buffer, static_cast<size_t>(received));
+        results_.bytes_read += static_cast<uint64_t>(received);
+        continue;
+      }
+      if (received < 0 && errno == EINTR) {
+        continue;
+      }
+      if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      }
+      if (received < 0) {
+        ++results_.read_errors;
+      }
+      closed = true;
+      break;
+    }
+
+    size_t consumed = 0;
+    bool server_closes = false;
+    while (!connection.in_flight.empty()) {
+      size_t size = 0;
+      int status = 0;
+      Framing framing = FrameResponse(std::string_view(connection.input).substr(consumed), size, status, server_closes);
+      if (framing == Framing::UNTIL_CLOSE && closed) {
+        size = connection.input.size() - consumed;
+      } else if (framing == Framing::INVALID) {
+        ++results_.read_errors;
+        closed = true;
+        break;
+      } else if (framing != Framing::COMPLETE) {
+        break;
+      }
+      Complete(connection, status, now);
+      consumed += size;
+      if (server_closes) {
+        break;
+      }
+    }
+    connection.input.erase(0, consumed);
+
+    if (closed || server_closes || !options_.keep_alive) {
+      connection.input.clear();
+      Reopen(connection);
+    }
+    Pump(connection, now);
+  }
+
+  void Complete(ClientConnection& connection, int status, int64_t now) {
+    results_.latency.Record(static_cast<uint64_t>(std::max<int64_t>(0, now - connection.in_flight.front())));
+    connection.in_flight.pop_front();
+    ++results_.responses;
+    if (status < 200 || status >= 300) {
+      ++results_.non_2xx;
+    }
+  }
+
+  const Options& options_;
+  std::string request_;
+  std::vector<ClientConnection> connections_;
+  int epoll_fd_{-1};
+
+  /** Open-loop: time between two requests of one connection; 0 when closed-loop */
+  int64_t interval_{0};
+
+  Results results_;
+};
+
+void Usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s [options] [http://host:port/path]\n"
+               "  -c, --connections N   open connections (default 16)\n"
+               "  -t, --threads N       worker threads (default 2)\n"
+               "  -d, --duration S      test length in seconds (default 10)\n"
+               "  -R, --rate N          total requests per second, open-loop (default: closed-loop)\n"
+               "  -p, --pipeline N      requests in flight per connection (default 1)\n"
+               "      --no-keepalive    one request per connection\n",
+               program);
+  std::exit(2);
+}
+
+/** Parse "http://host:port/path"; the scheme, port and path are optional */
+bool ParseUrl(std::string_view url, Options& options) {
+  if (url.starts_with("http://")) {
+    url.remove_prefix(7);
+  }
+  size_t slash = url.find('/');
+  std::string_view authority = url.substr(0, slash);
+  options.path = slash == std::string_view::npos ? "/" : std::string(url.substr(slash));
+  size_t colon = authority.find(':');
+  if (colon != std::string_view::npos) {
+    int port = std::atoi(std::string(authority.substr(colon + 1)).c_str());
+    if (port <= 0 || port > 65535) {
+      return false;
+    }
+    options.port = static_cast<uint16_t>(port);
+    authority = authority.substr(0, colon);
+  }
+  if (!authority.empty()) {
+    options.host = authority;
+  }
+  return true;
+}
+
+Options ParseOptions(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if ((arg == "-c" || arg == "--connections") && has_value) {
+      options.connections = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+    } else if ((arg == "-t" || arg == "--threads") && has_value) {
+      options.threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+    } else if ((arg == "-d" || arg == "--duration") && has_value) {
+      options.duration = std::max(0.1, std::atof(argv[++i]));
+    } else if ((arg == "-R" || arg == "--rate") && has_value) {
+      options.rate = std::max(0.0, std::atof(argv[++i]));
+    } else if ((arg == "-p" || arg == "--pipeline") && has_value) {
+      options.pipeline = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+    } else if (arg == "--no-keepalive") {
+      options.keep_alive = false;
+    } else if (!arg.starts_with("-") && ParseUrl(arg, options)) {
+      continue;
+    } else {
+      Usage(argv[0]);
+    }
+  }
+  options.threads = std::min(options.threads, options.connections);
+  return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options options = ParseOptions(argc, argv);
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  size_t assigned = 0;
+  for (size_t t = 0; t < options.threads; ++t) {
+    size_t share = options.connections / options.threads + (t < options.connections % options.threads ? 1 : 0);
+    workers.push_back(std::make_unique<Worker>(options, share, assigned));
+    assigned += share;
+  }
+
+  bool any_connected = false;
+  for (auto& worker : workers) {
+    any_connected = worker->Connect() || any_connected;
+  }
+  if (!any_connected) {
+    std::fprintf(stderr, "Could not connect to %s:%u\n", options.host.c_str(), options.port);
+    return 1;
+  }
+
+  std::printf("Running %.1fs test @ http://%s:%u%s\n", options.duration, options.host.c_str(), options.port, options.path.c_str());
+  std::printf("  %zu threads, %zu connections, pipeline %zu, %s, ", options.threads, options.connections, options.pipeline,
+              options.keep_alive ? "keep-alive" : "no keep-alive");
+  if (options.rate > 0) {
+    std::printf("open-loop at %.0f req/s\n", options.rate);
+  } else {
+    std::printf("closed-loop\n");
+  }
+  std::fflush(stdout);
+
+  int64_t start = Now();
+  int64_t deadline = start + static_cast<int64_t>(options.duration * 1e9);
+  std::vector<std::thread> threads;
+  for (auto& worker : workers) {
+    threads.emplace_back([&worker, start, deadline] { worker->Run(start, deadline); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  double elapsed = static_cast<double>(Now() - start) / 1e9;
+
+  Results total;
+  for (auto& worker : workers) {
+    const Results& results = worker->GetResults();
+    total.latency.Merge(results.latency);
+    total.responses += results.responses;
+    total.non_2xx += results.non_2xx;
+    total.bytes_read += results.bytes_read;
+    total.connect_errors += results.connect_errors;
+    total.read_errors += results.read_errors;
+    total.reconnects += results.reconnects;
+  }
+
+  const LatencyHistogram& latency = total.latency;
+  std::printf("\n  Latency (us)   mean %.1f, stdev %.1f, p50 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n", latency.Mean() / 1e3,
+              latency.StdDeviation() / 1e3, static_cast<double>(latency.ValueAtPercentile(50)) / 1e3,
+              static_cast<double>(latency.ValueAtPercentile(99)) / 1e3,
+              static_cast<double>(latency.ValueAtPercentile(99.9)) / 1e3, static_cast<double>(latency.Max()) / 1e3);
+  std::printf("  %llu responses in %.2fs, %.2f MB read\n", static_cast<unsigned long long>(total.responses), elapsed,
+              static_cast<double>(total.bytes_read) / 1e6);
+  if (total.non_2xx > 0 || total.connect_errors > 0 || total.read_errors > 0) {
+    std::printf("  Non-2xx responses: %llu, connect errors: %llu, read/write errors: %llu\n",
+                static_cast<unsigned long long>(total.non_2xx), static_cast<unsigned long long>(total.connect_errors),
+                static_cast<unsigned long long>(total.read_errors));
+  }
+  if (options.keep_alive && total.reconnects > 0) {
+    std::printf("  Reconnects after the server closed: %llu\n", static_cast<unsigned long long>(total.reconnects));
+  }
+  std::printf("Requests/sec: %.2f\n", static_cast<double>(total.responses) / elapsed);
+
+  std::printf("\n  Latency distribution (us, HdrHistogram percentile format)\n");
+  latency.PrintPercentiles(stdout, 1e3);
+  return 0;
+}
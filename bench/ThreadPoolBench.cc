@@ -0,0 +1,136 @@
+/**
+ * @file ThreadPoolBench.cc
+ * @brief Compare the work-stealing ThreadPool against the legacy mutex pool
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "LegacyThreadPool.h"
+
+#include <revak/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** Spin until the counter reaches the expected value */
+void WaitFor(const std::atomic<size_t>& counter, size_t expected) {
+  while (counter.load(std::memory_order_acquire) < expected) {
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * @brief External threads submit small tasks, as the event loop does
+ * @return Tasks per second
+ */
+template <typename Pool>
+double ExternalSubmit(size_t workers, size_t producers, size_t tasks_per_producer) {
+  Pool pool(workers);
+  std::atomic<size_t> done{0};
+  const size_t total = producers * tasks_per_producer;
+
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&] {
+      for (size_t i = 0; i < tasks_per_producer; ++i) {
+        pool.Enqueue([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  WaitFor(done, total);
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return static_cast<double>(total) / elapsed.count();
+}
+
+/** Enqueue a binary tree of tasks from inside the pool */
+template <typename Pool>
+void Spawn(Pool& pool, std::atomic<size_t>& done, int depth) {
+  if (depth > 0) {
+    pool.Enqueue([&pool, &done, depth] { Spawn(pool, done, depth - 1); });
+    pool.Enqueue([&pool, &done, depth] { Spawn(pool, done, depth - 1); });
+  }
+  done.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Tasks that enqueue follow-up tasks, the case work stealing targets
+ * @return Tasks per second
+ */
+template <typename Pool>
+double NestedSpawn(size_t workers, int depth) {
+  Pool pool(workers);
+  std::atomic<size_t> done{0};
+  const size_t total = (size_t{1} << (depth + 1)) - 1;
+
+  auto start = Clock::now();
+  pool.Enqueue([&pool, &done, depth] { Spawn(pool, done, depth); });
+  WaitFor(done, total);
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return static_cast<double>(total) / elapsed.count();
+}
+
+/**
+ * @brief One task in flight at a time, measuring wake-up latency
+ * @return Round trips per second
+ */
+template <typename Pool>
+double PingPong(size_t workers, size_t round_trips) {
+  Pool pool(workers);
+  std::atomic<size_t> done{0};
+
+  auto start = Clock::now();
+  for (size_t i = 0; i < round_trips; ++i) {
+    pool.Enqueue([&done] { done.fetch_add(1, std::memory_order_release); });
+    WaitFor(done, i + 1);
+  }
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return static_cast<double>(round_trips) / elapsed.count();
+}
+
+void Report(const char* name, double legacy, double stealing) {
+  std::printf("%-28s %14.0f %14.0f %8.2fx\n", name, legacy, stealing, stealing / legacy);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t workers = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    workers = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+  }
+  if (workers == 0) {
+    workers = 4;
+  }
+
+  using Legacy = revak::bench::LegacyThreadPool;
+  using Stealing = revak::ThreadPool;
+
+  std::printf("workers: %zu\n", workers);
+  std::printf("%-28s %14s %14s %9s\n", "case (ops/s)", "mutex", "stealing", "speedup");
+  Report("external, 1 producer",
+         ExternalSubmit<Legacy>(workers, 1, 1'000'000),
+         ExternalSubmit<Stealing>(workers, 1, 1'000'000));
+  Report("external, 4 producers",
+         ExternalSubmit<Legacy>(workers, 4, 250'000),
+         ExternalSubmit<Stealing>(workers, 4, 250'000));
+  Report("nested spawn, depth 20",
+         NestedSpawn<Legacy>(workers, 20),
+         NestedSpawn<Stealing>(workers, 20));
+  Report("ping-pong",
+         PingPong<Legacy>(workers, 100'000),
+         PingPong<Stealing>(workers, 100'000));
+  return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file AdmissionController.h
+ * @brief AdmissionController class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace revak {
+
+/**
+ * @class AdmissionController
+ * @brief Queue-delay based load shedding after CoDel
+ *
+ * Fed the time each task waited in the queue when it starts. A queue that
+ * is merely busy drains below the target delay now and then; one whose
+ * shortest delay stayed above the target for a whole interval holds a
+ * standing backlog, and the server is overloaded. While it is, tasks that
+ * waited longer than twice the target are shed: their clients have waited
+ * long already and the work behind them gets through in time, so goodput
+ * stays level instead of every request timing out. Thread-safe; a task
+ * that is not the interval's new minimum costs a few relaxed loads.
+ */
+class AdmissionController {
+public:
+  /**
+   * @brief Create a controller
+   * @param target Acceptable standing queue delay, 0 to admit everything
+   * @param interval Time the delay must stay above target to count as overload
+   */
+  explicit AdmissionController(std::chrono::milliseconds target = std::chrono::milliseconds(5),
+                               std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+  // Disable copy and assignment
+  AdmissionController(const AdmissionController&) = delete;
+  AdmissionController& operator=(const AdmissionController&) = delete;
+
+  /**
+   * @brief Change the target and interval
+   * @param target Acceptable standing queue delay, 0 to admit everything
+   * @param interval Time the delay must stay above target to count as overload
+   */
+  void SetTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval);
+
+  /**
+   * @brief Record the queue delay of a task about to run and decide whether to run it
+   * @param delay Time the task waited between its submission and now
+   * @return false if the task should be shed
+   */
+  bool Admit(std::chrono::nanoseconds delay);
+
+  /** @return true if the last full interval never saw the delay drop below the target */
+  bool Overloaded() const { return overloaded_.load(std::memory_order_relaxed); }
+
+private:
+  /** Target and interval in nanoseconds */
+  std::atomic<int64_t> target_ns_;
+  std::atomic<int64_t> interval_ns_;
+
+  /** Monotonic time the current interval ends */
+  std::atomic<int64_t> interval_end_ns_{0};
+
+  /** Shortest delay seen during the current interval */
+  std::atomic<int64_t> min_delay_ns_{std::numeric_limits<int64_t>::max()};
+
+  /** Verdict of the last full interval */
+  std::atomic<bool> overloaded_{false};
+};
+
+} // namespace revak
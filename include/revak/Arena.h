@@ -0,0 +1,102 @@
+/**
+ * @file Arena.h
+ * @brief Arena class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class Arena
+ * @brief Bump allocator whose memory is released all at once
+ *
+ * Allocation moves a cursor through a list of blocks; deallocation does
+ * nothing. Reset() rewinds the cursor and keeps the blocks, so once a
+ * connection's arena has grown to the size of its typical response,
+ * serving another one calls malloc not at all. Blocks beyond
+ * kRetainedBytes are freed on Reset() so one large response does not pin
+ * its memory for the connection's lifetime. Not thread-safe: used by one
+ * thread at a time, like the connection owning it.
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+  /** Memory kept across Reset() */
+  static constexpr size_t kRetainedBytes = 64 * 1024;
+
+  /**
+   * @brief Create an empty arena; nothing is allocated until first use
+   * @param block_size Size of the first block, later ones double
+   */
+  explicit Arena(size_t block_size = 4096) : block_size_(block_size) {}
+
+  // Disable copy and assignment
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /** Make all memory available again; everything allocated before must be gone */
+  void Reset();
+
+  /** @return Bytes held in blocks */
+  size_t Capacity() const;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+
+  /** Blocks in allocation order */
+  std::vector<Block> blocks_;
+
+  /** Block allocated from and offset of the cursor in it */
+  size_t current_{0};
+  size_t offset_{0};
+
+  /** Size of the first block */
+  size_t block_size_;
+};
+
+/**
+ * @brief Memory resource for allocations made on behalf of the current request
+ *
+ * Response allocates its headers from it. Outside a MemoryResourceScope it
+ * is std::pmr::get_default_resource().
+ * @return Resource of the calling thread
+ */
+std::pmr::memory_resource* CurrentMemoryResource();
+
+/**
+ * @class MemoryResourceScope
+ * @brief Make a resource the calling thread's CurrentMemoryResource() while in scope
+ *
+ * The server opens one around each request it dispatches, with the arena
+ * of the request's connection.
+ */
+class MemoryResourceScope {
+public:
+  explicit MemoryResourceScope(std::pmr::memory_resource* resource);
+  ~MemoryResourceScope();
+
+  // Disable copy and assignment
+  MemoryResourceScope(const MemoryResourceScope&) = delete;
+  MemoryResourceScope& operator=(const MemoryResourceScope&) = delete;
+
+private:
+  /** Resource restored when the scope ends */
+  std::pmr::memory_resource* previous_;
+};
+
+} // namespace revak
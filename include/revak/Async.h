@@ -0,0 +1,161 @@
+/**
+ * @file Async.h
+ * @brief Executor class and awaitable operations of coroutine handlers
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "EventLoop.h"
+#include "Task.h"
+
+#include <sys/types.h>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace revak {
+
+/**
+ * @class Executor
+ * @brief Where the coroutine handlers of a shard wait for I/O and where they resume
+ *
+ * Waits are registered on the shard's event loop; when one completes, the
+ * coroutine is resumed through the schedule function, on a thread pool
+ * worker or, in IoMode::SHARDED, back on the loop thread.
+ */
+class Executor {
+public:
+  /** Runs a resumption somewhere else than the calling thread */
+  using Schedule = std::function<void(std::function<void()>)>;
+
+  /**
+   * @brief Create an executor
+   * @param loop Event loop the waits are registered on
+   * @param schedule Runs the resumptions
+   */
+  Executor(EventLoop& loop, Schedule schedule) : loop_(loop), schedule_(std::move(schedule)) {}
+
+  /** @return Event loop the waits are registered on */
+  EventLoop& Loop() const { return loop_; }
+
+  /**
+   * @brief Resume a suspended coroutine through the schedule (thread-safe)
+   * @param handle Coroutine to resume
+   * @param memory Memory resource made current while it runs
+   */
+  void Resume(std::coroutine_handle<> handle, std::pmr::memory_resource* memory) const;
+
+private:
+  EventLoop& loop_;
+  Schedule schedule_;
+};
+
+namespace detail {
+
+/**
+ * @brief Suspend a coroutine until a timer expires
+ * @return false if it must not suspend (no executor: the wait already happened on this thread)
+ */
+bool SuspendFor(std::chrono::milliseconds duration, std::coroutine_handle<> handle, TaskPromiseBase& promise);
+
+/**
+ * @brief Suspend a coroutine until a file descriptor is ready
+ * @return false if it must not suspend (no executor: the wait already happened on this thread)
+ */
+bool SuspendUntilReady(int fd, uint32_t events, std::coroutine_handle<> handle, TaskPromiseBase& promise);
+
+} // namespace detail
+
+/**
+ * @class SleepAwaiter
+ * @brief Awaitable returned by Sleep()
+ */
+class SleepAwaiter {
+public:
+  explicit SleepAwaiter(std::chrono::milliseconds duration) : duration_(duration) {}
+
+  bool await_ready() const noexcept { return duration_.count() <= 0; }
+
+  template <typename Promise>
+  bool await_suspend(std::coroutine_handle<Promise> handle) {
+    return detail::SuspendFor(duration_, handle, handle.promise());
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  std::chrono::milliseconds duration_;
+};
+
+/**
+ * @class ReadyAwaiter
+ * @brief Awaitable returned by Readable() and Writable()
+ */
+class ReadyAwaiter {
+public:
+  ReadyAwaiter(int fd, uint32_t events) : fd_(fd), events_(events) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  bool await_suspend(std::coroutine_handle<Promise> handle) {
+    return detail::SuspendUntilReady(fd_, events_, handle, handle.promise());
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  int fd_;
+  uint32_t events_;
+};
+
+/**
+ * @brief Wait without holding a thread
+ *
+ * The timer runs on the shard's event loop and the handler resumes on a
+ * worker. Outside the server (no executor) the calling thread sleeps.
+ * @param duration Time to wait
+ * @return Awaitable
+ */
+inline SleepAwaiter Sleep(std::chrono::milliseconds duration) {
+  return SleepAwaiter(duration);
+}
+
+/**
+ * @brief Wait until a non-blocking descriptor can be read, or is closed or failed
+ * @param fd Descriptor owned by the handler, not watched by anything else meanwhile
+ * @return Awaitable
+ */
+ReadyAwaiter Readable(int fd);
+
+/**
+ * @brief Wait until a non-blocking descriptor can be written, or is closed or failed
+ * @param fd Descriptor owned by the handler, not watched by anything else meanwhile
+ * @return Awaitable
+ */
+ReadyAwaiter Writable(int fd);
+
+/**
+ * @brief Receive from a socket, suspending while nothing is available
+ * @param fd Socket (blocking or not), owned by the handler
+ * @param buffer Buffer receiving the bytes
+ * @param size Size of the buffer
+ * @return Bytes received, 0 once the peer closed, -1 on error (errno is set)
+ */
+Task<ssize_t> Receive(int fd, void* buffer, size_t size);
+
+/**
+ * @brief Send a whole buffer on a socket, suspending while it is full
+ * @param fd Socket (blocking or not), owned by the handler
+ * @param data Bytes to send
+ * @param size Number of bytes
+ * @return size once everything is sent, -1 on error (errno is set)
+ */
+Task<ssize_t> Send(int fd, const void* data, size_t size);
+
+} // namespace revak
@@ -0,0 +1,304 @@
+/**
+ * @file Connection.h
+ * @brief Connection class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "Arena.h"
+#include "RequestParser.h"
+#include "Response.h"
+#include "Socket.h"
+#include "TimerWheel.h"
+
+#include <sys/uio.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class Connection
+ * @brief State of one persistent client connection
+ *
+ * Owns the client socket together with its input and output buffers. With
+ * IoMode::EPOLL the loop thread reads into the input buffer until complete
+ * requests are parsed, and flushes queued responses with scatter-gather
+ * writes as the socket becomes writable. While a batch of requests is being handled on a worker thread
+ * the connection is marked busy and the loop does not touch its buffers.
+ * IoMode::BLOCKING drives the same buffers from one pool thread, and
+ * IoMode::IO_URING feeds them from ring completions (AppendInput(),
+ * GatherOutput(), CompleteOutput()). A reactor bounds each wait of the
+ * connection with its Timeout() timer, armed according to Waiting().
+ */
+class Connection {
+public:
+  /** Result of a non-blocking read or write pass */
+  enum class IoStatus {
+    OK,       ///< Made progress, socket would now block (or nothing left to write)
+    CLOSED,   ///< Peer closed the connection
+    ERROR,    ///< Unrecoverable socket error
+    TIMEOUT,  ///< A blocking read gave up (SO_RCVTIMEO)
+    FULL      ///< A read stopped at its input limit, more may wait on the socket
+  };
+
+  /** What the connection waits for, each bounded by its own timeout */
+  enum class Wait {
+    NONE,     ///< Nothing: a worker owns the connection
+    IDLE,     ///< The next request (keep-alive)
+    HEADERS,  ///< The rest of a request's line and headers
+    BODY,     ///< The rest of a request's body
+    OUTPUT    ///< The client to read queued responses
+  };
+
+  /**
+   * @brief Wrap an accepted client socket
+   * @param socket Client socket (non-blocking for IoMode::EPOLL)
+   * @param limits Request size limits
+   */
+  explicit Connection(Socket socket, RequestParser::Limits limits = {});
+
+  // Disable copy and assignment
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+
+  /**
+   * @brief Read what is available on the socket into the input buffer, up to a limit
+   *
+   * Edge-triggered readiness is not reported again for bytes left on the
+   * socket, so after IoStatus::FULL the caller reads again once it has
+   * consumed some input.
+   * @param max_input Unconsumed input at which reading stops
+   * @return IoStatus::OK when the socket would block, IoStatus::FULL at the limit
+   */
+  IoStatus ReadAvailable(size_t max_input);
+
+  /**
+   * @brief Perform a single read into the input buffer (blocking sockets)
+   * @return IoStatus::OK if bytes were read, IoStatus::TIMEOUT once the receive timeout expired
+   */
+  IoStatus ReadOnce();
+
+  /**
+   * @brief Bound how long the blocking reads wait for bytes (SO_RCVTIMEO)
+   * @param timeout Longest wait of one read, 0 to wait forever
+   * @return true if the timeout was set
+   */
+  bool SetReadTimeout(std::chrono::milliseconds timeout) { return socket_.SetReceiveTimeout(timeout); }
+
+  /**
+   * @brief Append bytes received by a completion-based reader (IoMode::IO_URING)
+   *
+   * Same rule as a read: only while the batch is empty and the connection not busy.
+   * @param data Received bytes
+   */
+  void AppendInput(std::string_view data);
+
+  /**
+   * @brief Write as much pending output as the socket accepts
+   * @return IoStatus::OK when the output is drained or the socket would block
+   */
+  IoStatus Flush();
+
+  /**
+   * @brief Parse the next request out of the input buffer
+   *
+   * Parsing resumes where the previous call stopped, so bytes are never
+   * scanned twice while a request trickles in.
+   * @param request Receives the request when the result is COMPLETE
+   * @return Parse result; on ERROR see ParseErrorStatus()
+   */
+  RequestParser::Result NextRequest(Request& request);
+
+  /** @return HTTP status of the last parse error (400, 413, 431 or 501) */
+  int ParseErrorStatus() const { return parser_.ErrorStatus(); }
+
+  /**
+   * @brief Requests parsed from the input buffer and not answered yet
+   *
+   * They view the input buffer, which is only compacted by the next read,
+   * so the batch must be handled and cleared before reading again. The
+   * storage is reused across batches.
+   * @return Pending requests, in arrival order
+   */
+  std::vector<Request>& Batch() { return batch_; }
+
+  /**
+   * @brief Get the arena the responses of this connection allocate from
+   *
+   * Only reset it while no response is pending (HasPendingOutput() is false).
+   * @return Arena of the connection
+   */
+  Arena& Memory() { return arena_; }
+
+  /**
+   * @brief Queue a response to be sent after the ones already queued
+   *
+   * The head is serialized into the shared head buffer right away; the body
+   * stays in the response and is sent from there without being copied.
+   * @param response Response to send
+   */
+  void QueueResponse(Response response);
+
+  /**
+   * @brief Describe the next unsent output that is in memory, for a caller that sends it itself
+   *
+   * Stops after the head of a file or streamed body, which only Flush() sends.
+   * The buffers stay valid until the bytes are reported with CompleteOutput().
+   * @param iov Receives the buffers
+   * @param max_count Capacity of iov (at least 2)
+   * @param file_follows Set to true if a file body follows the last buffer
+   * @return Number of buffers filled, 0 if Flush() has to send the next bytes
+   */
+  size_t GatherOutput(iovec* iov, size_t max_count, bool& file_follows) const;
+
+  /**
+   * @brief Account for bytes of GatherOutput() buffers that were sent
+   * @param bytes Number of bytes the socket accepted
+   */
+  void CompleteOutput(size_t bytes);
+
+  /** @return true if there are unsent output bytes */
+  bool HasPendingOutput() const { return !pending_.empty(); }
+
+  /** @return true if Flush() stopped because a streamed body needs its next piece */
+  bool NeedsStreamData() const;
+
+  /**
+   * @brief Pull the next piece of the streamed body being sent
+   *
+   * Runs the response's BodyStream, so it may be slow; call it only when
+   * NeedsStreamData() is true and follow it with Flush().
+   */
+  void PullStreamData();
+
+  /** @return Number of requests answered on this connection so far */
+  size_t RequestsServed() const { return requests_served_; }
+
+  /** Count one more answered request */
+  void CountRequest() { ++requests_served_; }
+
+  /** @return What the connection waits for now */
+  Wait Waiting() const;
+
+  /** @return Wait the Timeout() timer was last armed for */
+  Wait TimedWait() const { return timed_wait_; }
+
+  /** @param wait Wait the Timeout() timer is armed for */
+  void SetTimedWait(Wait wait) { timed_wait_ = wait; }
+
+  /** @return Timer bounding the current wait, armed in the reactor's wheel */
+  TimerWheel::Timer& Timeout() { return timeout_; }
+
+  /** @return true while a worker thread owns the connection buffers */
+  bool IsBusy() const { return busy_; }
+
+  /** @param busy Mark the connection as owned by a worker thread */
+  void SetBusy(bool busy) { busy_ = busy; }
+
+  /** @return true if the connection should be closed once output is flushed */
+  bool IsClosing() const { return closing_; }
+
+  /** Close the connection once the pending output is flushed; only by the thread owning the buffers */
+  void MarkClosing() { closing_ = true; }
+
+  /** @return true if the socket reported an error while a worker owned the connection */
+  bool HasPendingError() const { return error_pending_; }
+
+  /** Record a socket error seen by the loop thread, acted on once the connection is handed back */
+  void MarkErrorPending() { error_pending_ = true; }
+
+  /**
+   * @brief Get the native file descriptor of the client socket
+   * @return File descriptor as an integer
+   */
+  [[nodiscard]] int NativeHandle() const { return socket_.NativeHandle(); }
+
+private:
+  /** Drop the consumed prefix of the input buffer before reading more */
+  void CompactInput();
+
+  /**
+   * @brief Move the flush cursor past bytes that were written
+   * @param bytes Number of bytes the socket accepted
+   */
+  void AdvanceOutput(size_t bytes);
+
+  /** Drop the queued responses once all of them are sent */
+  void ClearSentOutput();
+
+  /** Client socket */
+  Socket socket_;
+
+  /** Memory of the queued responses; declared first among them so it is destroyed after them */
+  Arena arena_;
+
+  /** Bytes received; everything before input_offset_ is consumed */
+  std::string input_;
+
+  /** Offset of the first byte of the request being parsed */
+  size_t input_offset_{0};
+
+  /** Parser state of the request being received */
+  RequestParser parser_;
+
+  /** Parsed requests waiting to be answered */
+  std::vector<Request> batch_;
+
+  /** A queued response and the location of its serialized head */
+  struct PendingResponse {
+    Response response;
+    size_t head_offset;
+    size_t head_length;
+  };
+
+  /** Status lines and header blocks of the queued responses, reused across batches */
+  std::string head_buffer_;
+
+  /** Responses waiting to be sent, in order */
+  std::vector<PendingResponse> pending_;
+
+  /** Index of the first pending response not completely sent */
+  size_t flush_index_{0};
+
+  /** Bytes of pending_[flush_index_] (head then body) already sent */
+  size_t flush_offset_{0};
+
+  /** Framed piece of the streamed body being sent */
+  std::string stream_buffer_;
+
+  /** Bytes of stream_buffer_ already sent */
+  size_t stream_offset_{0};
+
+  /** Piece returned by the stream, before framing (reused) */
+  std::string stream_chunk_;
+
+  /** True once the stream produced its last piece */
+  bool stream_finished_{false};
+
+  /** Number of requests answered on this connection */
+  size_t requests_served_{0};
+
+  /** Timer bounding the current wait */
+  TimerWheel::Timer timeout_;
+
+  /** Wait timeout_ was last armed for */
+  Wait timed_wait_{Wait::NONE};
+
+  /** True while a worker thread handles requests of this connection */
+  bool busy_{false};
+
+  /** True when the connection is closed after the output is flushed */
+  bool closing_{false};
+
+  /** Loop-side: the socket failed while busy, closing_ then belonging to the worker */
+  bool error_pending_{false};
+};
+
+} // namespace revak
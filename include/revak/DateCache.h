@@ -0,0 +1,79 @@
+/**
+ * @file DateCache.h
+ * @brief DateCache class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace revak {
+
+/**
+ * @class DateCache
+ * @brief Singleton cache of the current IMF-fixdate used for the Date header
+ *
+ * The date only changes once per second, so it is formatted once per
+ * second and shared by every worker. Readers never block: the value is
+ * published with a sequence lock and a reader that races with the refresh
+ * simply retries its copy.
+ */
+class DateCache {
+public:
+  /** Length of an IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") */
+  static constexpr size_t kDateLength = 29;
+
+  /**
+   * @brief Get the singleton instance of DateCache
+   * @return Reference to the DateCache instance
+   */
+  static DateCache& Instance();
+
+  // Disable copy and assignment
+  DateCache(const DateCache&) = delete;
+  DateCache& operator=(const DateCache&) = delete;
+
+  /**
+   * @brief Append the current date to a buffer
+   * @param out Buffer to append kDateLength characters to
+   */
+  void Append(std::string& out);
+
+  /**
+   * @brief Format any second as an IMF-fixdate (e.g. for Last-Modified)
+   * @param second Seconds since the epoch
+   * @param out Receives kDateLength characters
+   */
+  static void Format(int64_t second, char* out);
+
+private:
+  /** Private constructor for singleton pattern */
+  DateCache() = default;
+
+  /**
+   * @brief Format and publish the date of a new second (one thread at a time)
+   * @param second Seconds since the epoch
+   */
+  void Refresh(int64_t second);
+
+  /** Number of 8-byte words holding the date */
+  static constexpr size_t kWords = (kDateLength + 7) / 8;
+
+  /** Sequence counter, odd while the date is being rewritten */
+  std::atomic<uint64_t> sequence_{0};
+
+  /** Second the cached date belongs to, -1 before the first refresh */
+  std::atomic<int64_t> second_{-1};
+
+  /** Formatted date, stored as atomic words so racing reads are well defined */
+  std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+} // namespace revak
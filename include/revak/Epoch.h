@@ -0,0 +1,131 @@
+/**
+ * @file Epoch.h
+ * @brief Epoch class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class Epoch
+ * @brief Singleton epoch-based reclamation of data published through atomic pointers
+ *
+ * Readers enter a Guard, load the published pointer and use what it points
+ * to until the guard ends. A writer publishes a replacement, then hands the
+ * old object to Retire(), which frees it once every reader that might still
+ * see it has left its guard. Entering a guard stores the global epoch into
+ * the thread's own cache line and leaving it stores "idle": readers take no
+ * lock and write nothing another thread writes. The epoch advances when
+ * every reader inside a guard has seen the current one, and an object
+ * retired in epoch e is freed once the epoch reaches e + 2.
+ *
+ * Writers pay for the reclamation: Retire() takes a mutex and scans every
+ * thread's slot. A reader staying in its guard delays the frees, never the
+ * writers. Guards nest.
+ * @code
+ * {
+ *   Epoch::Guard guard;
+ *   const Table* table = table_.load(std::memory_order_acquire);
+ *   ... // table stays valid until the guard ends
+ * }
+ * @endcode
+ */
+class Epoch {
+private:
+  /** Epoch announcement of one thread, alone on its cache line */
+  struct Slot;
+
+  /** Thread-local owner of a thread's slot, orphaning it when the thread exits */
+  struct ThreadSlot;
+
+public:
+  /**
+   * @class Guard
+   * @brief Critical section during which retired objects are not freed
+   */
+  class Guard {
+  public:
+    Guard();
+    ~Guard();
+
+    // Disable copy and assignment
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+  private:
+    /** Slot of the thread the guard was entered on */
+    ThreadSlot& local_;
+  };
+
+  /**
+   * @brief Get the singleton instance of Epoch
+   * @return Reference to the Epoch instance
+   */
+  static Epoch& Instance();
+
+  /** Run the reclamations still pending */
+  ~Epoch();
+
+  // Disable copy and assignment
+  Epoch(const Epoch&) = delete;
+  Epoch& operator=(const Epoch&) = delete;
+
+  /**
+   * @brief Free an object once no reader can still see it
+   *
+   * Call it after the object is unpublished. Reclamations that became safe,
+   * this one or earlier ones, run before it returns, on the calling thread.
+   * @param reclaim Frees the object
+   */
+  void Retire(std::function<void()> reclaim);
+
+  /** @return Number of retired objects not freed yet */
+  size_t Pending() const;
+
+private:
+  /** Private constructor for singleton pattern */
+  Epoch() = default;
+
+  /** Retired object and the epoch it was retired in */
+  struct Retired {
+    uint64_t epoch;
+    std::function<void()> reclaim;
+  };
+
+  /** @return Slot of the calling thread, registered on first use */
+  static ThreadSlot& LocalSlot();
+
+  /**
+   * @brief Advance the epoch as far as the readers allow and take what became safe to free
+   * @return Reclamations to run, outside of the mutex
+   */
+  std::vector<std::function<void()>> Collect();
+
+  /** Slot value of a thread outside of any guard */
+  static constexpr uint64_t kIdle = UINT64_MAX;
+
+  /** Current epoch */
+  std::atomic<uint64_t> global_{0};
+
+  /** Guards slots_ and retired_ */
+  mutable std::mutex mutex_;
+
+  /** Slots of the threads that entered a guard, shared with their ThreadSlot */
+  std::vector<std::shared_ptr<Slot>> slots_;
+
+  /** Objects waiting for their epoch to pass */
+  std::vector<Retired> retired_;
+};
+
+}  // namespace revak
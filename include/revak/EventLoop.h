@@ -0,0 +1,161 @@
+/**
+ * @file EventLoop.h
+ * @brief EventLoop class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "TimerWheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class EventLoop
+ * @brief Edge-triggered epoll reactor that multiplexes many file descriptors on one thread
+ *
+ * Watched descriptors are registered with a callback that receives the ready
+ * epoll event mask. Other threads hand work back to the loop with Post(),
+ * which wakes the loop through an eventfd. Timers live in the loop's
+ * TimerWheel, whose timerfd is watched like any other descriptor.
+ */
+class EventLoop {
+public:
+  /** Callback invoked with the ready epoll event mask */
+  using EventCallback = std::function<void(uint32_t events)>;
+
+  /** Create the epoll instance and its wakeup eventfd */
+  EventLoop();
+
+  /** Close the epoll instance and the wakeup eventfd */
+  ~EventLoop();
+
+  // Disable copy and assignment
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /**
+   * @brief Start watching a file descriptor
+   * @param fd File descriptor to watch (should be non-blocking)
+   * @param events epoll event mask (EPOLLET is added automatically)
+   * @param callback Callback invoked when the descriptor becomes ready
+   * @return true if the descriptor was registered, false otherwise
+   */
+  bool Add(int fd, uint32_t events, EventCallback callback);
+
+  /**
+   * @brief Stop watching a file descriptor
+   *
+   * The callback is kept alive until the current dispatch round finishes,
+   * so it is safe to call Remove() from inside the callback itself, and it
+   * is not run for events of the round fetched before the removal.
+   * @param fd File descriptor to remove
+   */
+  void Remove(int fd);
+
+  /**
+   * @brief Destroy an object once the current dispatch round finishes (loop thread only)
+   *
+   * For state that callbacks of the round may still point to, such as a
+   * connection closed while later events for it wait in the same batch.
+   * @param object Object to keep alive until then
+   */
+  void Retire(std::shared_ptr<void> object);
+
+  /**
+   * @brief Run a task periodically on the loop thread
+   * @param interval Time between two runs
+   * @param task Task to execute
+   * @return true if the timer was armed, false otherwise
+   */
+  bool RunEvery(std::chrono::milliseconds interval, std::function<void()> task);
+
+  /**
+   * @brief Run a task once on the loop thread after a delay (loop thread only)
+   * @param delay Time before the run, rounded up to the wheel's tick
+   * @param task Task to execute
+   * @return true if the timer was armed, false otherwise
+   */
+  bool RunAfter(std::chrono::milliseconds delay, std::function<void()> task);
+
+  /** @return Timers of the loop (loop thread only) */
+  TimerWheel& Timers() { return timers_; }
+
+  /**
+   * @brief Queue a task to run on the loop thread (thread-safe)
+   * @param task Task to execute
+   */
+  void Post(std::function<void()> task);
+
+  /** Run the loop on the calling thread until Stop() is called */
+  void Run();
+
+  /**
+   * @brief Wait once for ready descriptors and dispatch them, with posted tasks and timers
+   *
+   * Lets another reactor drive this loop: the epoll instance (NativeHandle())
+   * becomes readable whenever RunOnce() has work to do.
+   * @param timeout_ms Longest wait in milliseconds, 0 to only dispatch what is ready, -1 to block
+   * @return false if epoll_wait failed
+   */
+  bool RunOnce(int timeout_ms);
+
+  /** Ask the loop to return from Run() (thread-safe) */
+  void Stop();
+
+  /** @return true once Stop() was called */
+  bool IsStopped() const { return stop_; }
+
+  /** @return File descriptor of the epoll instance */
+  [[nodiscard]] int NativeHandle() const { return epoll_fd_; }
+
+private:
+  /** Drain the wakeup eventfd and run posted tasks */
+  void RunPostedTasks();
+
+  /** Wake the loop thread out of epoll_wait */
+  void Wakeup();
+
+  /** epoll instance file descriptor */
+  int epoll_fd_{-1};
+
+  /** eventfd used to wake the loop from other threads */
+  int wakeup_fd_{-1};
+
+  /** timerfds armed by RunEvery() */
+  std::vector<int> timer_fds_;
+
+  /** One-shot timers, armed by RunAfter() and by the users of Timers() */
+  TimerWheel timers_;
+
+  /** Objects retired during the current dispatch round, destroyed before timers_ they may link into */
+  std::vector<std::shared_ptr<void>> graveyard_;
+
+  /** Atomic flag to stop the loop */
+  std::atomic<bool> stop_{false};
+
+  /** Callbacks of the watched descriptors, keyed by fd */
+  std::unordered_map<int, std::unique_ptr<EventCallback>> callbacks_;
+
+  /** Callbacks removed during the current dispatch round */
+  std::vector<std::unique_ptr<EventCallback>> retired_;
+
+  /** Mutex for the posted task queue */
+  std::mutex post_mutex_;
+
+  /** Tasks posted from other threads */
+  std::vector<std::function<void()>> posted_;
+};
+
+} // namespace revak
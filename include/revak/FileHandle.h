@@ -0,0 +1,49 @@
+/**
+ * @file FileHandle.h
+ * @brief FileHandle class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <unistd.h>
+
+namespace revak {
+
+/**
+ * @class FileHandle
+ * @brief Owns an open file descriptor and closes it on destruction
+ */
+class FileHandle {
+public:
+  /**
+   * @brief Take ownership of a file descriptor
+   * @param fd Open file descriptor
+   */
+  explicit FileHandle(int fd) : fd_(fd) {}
+
+  /** Close the file descriptor */
+  ~FileHandle() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  // Delete Copy
+  FileHandle(const FileHandle&) = delete;
+  FileHandle& operator=(const FileHandle&) = delete;
+
+  /**
+   * @brief Get the native file descriptor
+   * @return File descriptor as an integer
+   */
+  [[nodiscard]] int NativeHandle() const { return fd_; }
+
+private:
+  /** Owned file descriptor */
+  int fd_{-1};
+};
+
+} // namespace revak
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "Task.h"
+
 #include <functional>
 
 namespace revak {
@@ -29,5 +31,22 @@ class Request;
  */
 using Handler = std::function<Response(const Request&)>;
 
+/**
+ * @typedef AsyncHandler
+ * @brief Type definition for coroutine request handlers
+ *
+ * The handler suspends on awaitable I/O (Sleep(), Readable(), Receive()...)
+ * without holding a thread; the request stays valid until it returns.
+ * @code
+ * server.Get("/slow", [](const Request& req) -> Task<Response> {
+ *   co_await Sleep(std::chrono::milliseconds(100));
+ *   Response res;
+ *   res.SetBody("Done");
+ *   co_return res;
+ * });
+ * @endcode
+ */
+using AsyncHandler = std::function<Task<Response>(const Request&)>;
+
 
 } // namespace revak
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file HeaderScanner.h
+ * @brief HeaderScanner class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace revak {
+
+namespace detail {
+
+/** RFC 9110 token characters: ALPHA, DIGIT and !#$%&'*+-.^_`|~ */
+constexpr std::array<bool, 256> kTokenChars = [] {
+  std::array<bool, 256> table{};
+  for (unsigned c = '0'; c <= '9'; ++c) table[c] = true;
+  for (unsigned c = 'A'; c <= 'Z'; ++c) table[c] = true;
+  for (unsigned c = 'a'; c <= 'z'; ++c) table[c] = true;
+  for (char c : std::string_view("!#$%&'*+-.^_`|~")) table[static_cast<unsigned char>(c)] = true;
+  return table;
+}();
+
+} // namespace detail
+
+/** Check for an RFC 9110 token character (method and header names) */
+inline bool IsTokenChar(char c) {
+  return detail::kTokenChars[static_cast<unsigned char>(c)];
+}
+
+/**
+ * @class HeaderScanner
+ * @brief Single-pass search for the end of a request line or header line
+ *
+ * FindLineEnd() looks for the line feed ending the current line and, on
+ * the same bytes, records the first colon and whether every byte before
+ * it is a token character, so a header line is split and its name
+ * validated without scanning it again. The scan works on 32 (AVX2) or 16
+ * (SSE4.2) bytes at a time, classifying token characters with nibble
+ * lookup tables, and finishes the last bytes one at a time. The widest
+ * implementation the CPU supports is picked at startup.
+ *
+ * The line state survives between calls, so a line that arrives in
+ * several reads is scanned once: resume at the position the previous call
+ * stopped at and call NextLine() only when a line is complete.
+ */
+class HeaderScanner {
+public:
+  /** Scanning implementation */
+  enum class Implementation {
+    SCALAR,  ///< One byte at a time, any CPU
+    SSE42,   ///< 16 bytes at a time
+    AVX2     ///< 32 bytes at a time
+  };
+
+  /**
+   * @brief Find the next line feed, recording the current line's colon and name validity
+   * @param data Buffer holding the line
+   * @param position Offset to resume at: the line start, or where the previous call stopped
+   * @return Offset of the line feed, std::string_view::npos if data ends first
+   */
+  size_t FindLineEnd(std::string_view data, size_t position);
+
+  /** @return Offset of the first colon of the current line, npos if none was seen */
+  size_t Colon() const { return line_.colon; }
+
+  /** @return True if every byte before the colon (or scanned so far without one) is a token character */
+  bool NameValid() const { return line_.name_valid; }
+
+  /** Forget the current line; call once it is complete */
+  void NextLine() { line_ = Line{}; }
+
+  /**
+   * @brief Select the implementation used by every scanner (benchmarks; call before serving)
+   * @param implementation Implementation to use
+   * @return false if the CPU does not support it (the selection is unchanged)
+   */
+  static bool Use(Implementation implementation);
+
+  /** @return Widest implementation supported by the CPU */
+  static Implementation Best();
+
+  /** @return Implementation in use */
+  static Implementation Active();
+
+  /** @return Implementation name: "scalar", "sse4.2" or "avx2" */
+  static std::string_view Name(Implementation implementation);
+
+  /** What is known about the line being scanned */
+  struct Line {
+    /** Offset of the first colon, npos until one is seen */
+    size_t colon{std::string_view::npos};
+
+    /** False once a non-token byte precedes the colon */
+    bool name_valid{true};
+  };
+
+private:
+  Line line_;
+};
+
+} // namespace revak
@@ -0,0 +1,130 @@
+/**
+ * @file Histogram.h
+ * @brief Histogram class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace revak {
+
+/**
+ * @class Histogram
+ * @brief Log-linear latency histogram written by one thread and read by any
+ *
+ * Durations in nanoseconds fall into eight linear buckets per power of
+ * two, from 1 µs up to about a minute (below and above are clamped into
+ * the first and last bucket), so a quantile is known to within 12.5%.
+ * Only the owning thread records, with plain loads and stores of relaxed
+ * atomics (no locked instruction); readers add snapshots of several
+ * histograms together.
+ */
+class Histogram {
+public:
+  /** Linear buckets per power of two */
+  static constexpr size_t kSubBuckets = 8;
+
+  /** First power of two with its own buckets (2^10 ns, about 1 µs) */
+  static constexpr unsigned kMinShift = 10;
+
+  /** Last power of two with its own buckets (2^35 ns, about 34 s to 69 s) */
+  static constexpr unsigned kMaxShift = 35;
+
+  /** One underflow bucket, then kSubBuckets per power of two */
+  static constexpr size_t kBuckets = 1 + (kMaxShift - kMinShift + 1) * kSubBuckets;
+
+  /**
+   * @struct Snapshot
+   * @brief Plain copy of one or more histograms
+   */
+  struct Snapshot {
+    std::array<uint64_t, kBuckets> counts{};
+    uint64_t count{0};
+    uint64_t sum{0};
+
+    /**
+     * @brief Estimate a quantile
+     * @param q Quantile between 0 and 1
+     * @return Upper bound of the bucket holding it, in nanoseconds; 0 if empty
+     */
+    uint64_t Quantile(double q) const {
+      if (count == 0) {
+        return 0;
+      }
+      auto rank = static_cast<uint64_t>(q * static_cast<double>(count));
+      uint64_t seen = 0;
+      for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen > rank) {
+          return UpperBound(i);
+        }
+      }
+      return UpperBound(kBuckets - 1);
+    }
+  };
+
+  /**
+   * @brief Count one duration (owning thread only)
+   * @param nanoseconds Duration
+   */
+  void Record(uint64_t nanoseconds) {
+    Bump(counts_[Index(nanoseconds)], 1);
+    Bump(count_, 1);
+    Bump(sum_, nanoseconds);
+  }
+
+  /**
+   * @brief Add the current counts to a snapshot (any thread)
+   * @param snapshot Snapshot to add to
+   */
+  void AddTo(Snapshot& snapshot) const {
+    for (size_t i = 0; i < kBuckets; ++i) {
+      snapshot.counts[i] += counts_[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count += count_.load(std::memory_order_relaxed);
+    snapshot.sum += sum_.load(std::memory_order_relaxed);
+  }
+
+  /** @return Bucket counting a duration */
+  static size_t Index(uint64_t nanoseconds) {
+    if (nanoseconds < (uint64_t{1} << kMinShift)) {
+      return 0;
+    }
+    unsigned shift = static_cast<unsigned>(std::bit_width(nanoseconds)) - 1;
+    if (shift > kMaxShift) {
+      return kBuckets - 1;
+    }
+    size_t sub = static_cast<size_t>(nanoseconds >> (shift - 3)) & (kSubBuckets - 1);
+    return 1 + (shift - kMinShift) * kSubBuckets + sub;
+  }
+
+  /** @return Exclusive upper bound of a bucket, in nanoseconds */
+  static uint64_t UpperBound(size_t index) {
+    if (index == 0) {
+      return uint64_t{1} << kMinShift;
+    }
+    unsigned shift = kMinShift + static_cast<unsigned>((index - 1) / kSubBuckets);
+    uint64_t sub = (index - 1) % kSubBuckets;
+    return (kSubBuckets + sub + 1) << (shift - 3);
+  }
+
+private:
+  /** Single-writer increment: a relaxed load and store, no read-modify-write */
+  static void Bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+};
+
+} // namespace revak
@@ -0,0 +1,192 @@
+/**
+ * @file HttpHeader.h
+ * @brief Well-known header names, recognised while parsing into fixed request slots
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace revak {
+
+/**
+ * @enum HttpHeader
+ * @brief Header fields the server and typical handlers read, found in O(1) by Request::Header()
+ */
+enum class HttpHeader : uint8_t {
+  HOST,
+  CONNECTION,
+  CONTENT_LENGTH,
+  CONTENT_TYPE,
+  TRANSFER_ENCODING,
+  ACCEPT,
+  ACCEPT_ENCODING,
+  ACCEPT_LANGUAGE,
+  USER_AGENT,
+  COOKIE,
+  AUTHORIZATION,
+  CACHE_CONTROL,
+  IF_NONE_MATCH,
+  IF_MODIFIED_SINCE,
+  RANGE,
+  IF_RANGE,
+  REFERER,
+  ORIGIN,
+  UPGRADE,
+  EXPECT,
+  OTHER ///< Any other name, looked up by a scan of the headers
+};
+
+/** Number of well-known headers, the values of HttpHeader before OTHER */
+inline constexpr size_t kKnownHeaders = static_cast<size_t>(HttpHeader::OTHER);
+
+namespace detail {
+
+/** Canonical header names, indexed by HttpHeader */
+inline constexpr std::string_view kHeaderNames[] = {
+  "Host", "Connection", "Content-Length", "Content-Type", "Transfer-Encoding", "Accept", "Accept-Encoding",
+  "Accept-Language", "User-Agent", "Cookie", "Authorization", "Cache-Control", "If-None-Match",
+  "If-Modified-Since", "Range", "If-Range", "Referer", "Origin", "Upgrade", "Expect",
+};
+
+static_assert(std::size(kHeaderNames) == kKnownHeaders);
+
+/** ASCII lower case, header names being ASCII tokens */
+constexpr char AsciiLower(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/** Case-insensitive comparison for header names and tokens */
+constexpr bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](char x, char y) { return AsciiLower(x) == AsciiLower(y); });
+}
+
+/**
+ * @struct HeaderNameLess
+ * @brief Case-insensitive ordering of header names, for maps where "content-length" is "Content-Length"
+ */
+struct HeaderNameLess {
+  using is_transparent = void;
+
+  bool operator()(std::string_view a, std::string_view b) const {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                        [](char x, char y) { return AsciiLower(x) < AsciiLower(y); });
+  }
+};
+
+/** Longest well-known name plus one */
+inline constexpr size_t kHeaderLengths = 18;
+
+/** Shortest well-known name */
+inline constexpr size_t kShortestHeader = 4;
+
+/**
+ * @brief Load up to eight bytes of a name into a word, little-endian
+ * @param name Name holding the bytes
+ * @param at Offset of the first byte
+ * @param count Number of bytes, 4 or 8
+ */
+constexpr uint64_t LoadNameBytes(std::string_view name, size_t at, size_t count) {
+  if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+    uint64_t word = 0;
+    std::memcpy(&word, name.data() + at, count);
+    return word;
+  }
+  uint64_t word = 0;
+  for (size_t b = 0; b < count; ++b) {
+    word |= uint64_t{static_cast<unsigned char>(name[at + b])} << (8 * b);
+  }
+  return word;
+}
+
+/**
+ * @brief Cover a name of 4 to 24 bytes with overlapping loads, the case bit of each byte set
+ *
+ * Setting 0x20 lower-cases letters and leaves '-' and digits as they are, so
+ * equal words mean names equal ignoring case, as far as token characters go:
+ * a control character could alias one of them, but header names are tokens.
+ */
+constexpr std::array<uint64_t, 3> NameWords(std::string_view name) {
+  constexpr uint64_t kCaseBits = 0x2020202020202020ULL;
+  size_t size = name.size();
+  if (size < 8) {
+    return {(LoadNameBytes(name, 0, 4) | LoadNameBytes(name, size - 4, 4) << 32) | kCaseBits, 0, 0};
+  }
+  return {LoadNameBytes(name, 0, 8) | kCaseBits, size > 16 ? LoadNameBytes(name, 8, 8) | kCaseBits : 0,
+          LoadNameBytes(name, size - 8, 8) | kCaseBits};
+}
+
+/** NameWords() of each well-known name */
+inline constexpr auto kHeaderWords = [] {
+  std::array<std::array<uint64_t, 3>, kKnownHeaders> words{};
+  for (size_t i = 0; i < kKnownHeaders; ++i) {
+    words[i] = NameWords(kHeaderNames[i]);
+  }
+  return words;
+}();
+
+/** Well-known headers by name length, at most four per length, kKnownHeaders filling the rest */
+inline constexpr auto kHeadersByLength = [] {
+  std::array<std::array<uint8_t, 4>, kHeaderLengths> table{};
+  for (auto& candidates : table) {
+    candidates.fill(static_cast<uint8_t>(kKnownHeaders));
+  }
+  for (size_t i = 0; i < kKnownHeaders; ++i) {
+    auto& candidates = table[kHeaderNames[i].size()];
+    *std::find(candidates.begin(), candidates.end(), kKnownHeaders) = static_cast<uint8_t>(i);
+  }
+  return table;
+}();
+
+} // namespace detail
+
+/**
+ * @brief Recognise a header name, case-insensitively
+ * @param name Header name
+ * @return The header, HttpHeader::OTHER if it is not a well-known one
+ */
+constexpr HttpHeader ParseHeader(std::string_view name) {
+  // Only the names of the same length are compared, at most four, a few words each
+  if (name.size() < detail::kShortestHeader || name.size() >= detail::kHeaderLengths) {
+    return HttpHeader::OTHER;
+  }
+  std::array<uint64_t, 3> words = detail::NameWords(name);
+  for (uint8_t index : detail::kHeadersByLength[name.size()]) {
+    if (index == kKnownHeaders) {
+      break;
+    }
+    if (detail::kHeaderWords[index] == words) {
+      return static_cast<HttpHeader>(index);
+    }
+  }
+  return HttpHeader::OTHER;
+}
+
+/**
+ * @brief Get the canonical name of a header
+ * @param header A well-known header
+ * @return Header name (e.g. "Content-Length"), empty for HttpHeader::OTHER
+ */
+constexpr std::string_view HeaderName(HttpHeader header) {
+  size_t index = static_cast<size_t>(header);
+  return index < kKnownHeaders ? detail::kHeaderNames[index] : std::string_view();
+}
+
+static_assert(ParseHeader("content-length") == HttpHeader::CONTENT_LENGTH);
+static_assert(ParseHeader("IF-RANGE") == HttpHeader::IF_RANGE);
+static_assert(ParseHeader("X-Request-Id") == HttpHeader::OTHER);
+static_assert(HeaderName(HttpHeader::IF_NONE_MATCH) == "If-None-Match");
+
+} // namespace revak
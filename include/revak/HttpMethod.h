@@ -0,0 +1,77 @@
+/**
+ * @file HttpMethod.h
+ * @brief Request methods recognised while parsing, compared as integers
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace revak {
+
+/**
+ * @enum HttpMethod
+ * @brief Methods of RFC 9110 section 9 and PATCH (RFC 5789)
+ *
+ * Methods are case-sensitive, so "get" is OTHER. OTHER requests keep their
+ * method text in Request::Method(), which is then what must be compared.
+ */
+enum class HttpMethod : uint8_t {
+  GET,
+  HEAD,
+  POST,
+  PUT,
+  DELETE,
+  CONNECT,
+  OPTIONS,
+  TRACE,
+  PATCH,
+  OTHER ///< Any other token
+};
+
+namespace detail {
+
+/** Method names, indexed by HttpMethod */
+inline constexpr std::string_view kMethodNames[] = {
+  "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH",
+};
+
+} // namespace detail
+
+/**
+ * @brief Recognise a method token
+ * @param method Method as sent in the request line
+ * @return The method, HttpMethod::OTHER if it is not a known one
+ */
+constexpr HttpMethod ParseMethod(std::string_view method) {
+  // The length and the first letter rule out most names before the comparison
+  for (size_t i = 0; i < std::size(detail::kMethodNames); ++i) {
+    if (detail::kMethodNames[i].size() == method.size() && detail::kMethodNames[i][0] == method[0]
+        && detail::kMethodNames[i] == method) {
+      return static_cast<HttpMethod>(i);
+    }
+  }
+  return HttpMethod::OTHER;
+}
+
+/**
+ * @brief Get the name of a method
+ * @param method A known method
+ * @return Method name, empty for HttpMethod::OTHER
+ */
+constexpr std::string_view MethodName(HttpMethod method) {
+  size_t index = static_cast<size_t>(method);
+  return index < std::size(detail::kMethodNames) ? detail::kMethodNames[index] : std::string_view();
+}
+
+static_assert(ParseMethod("DELETE") == HttpMethod::DELETE);
+static_assert(ParseMethod("get") == HttpMethod::OTHER);
+static_assert(MethodName(HttpMethod::PATCH) == "PATCH");
+
+} // namespace revak
@@ -0,0 +1,120 @@
+/**
+ * @file HttpStatus.h
+ * @brief Compile-time table of pre-rendered HTTP status lines
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace revak {
+
+namespace detail {
+
+/** A status code with its full "HTTP/1.1 NNN Text\r\n" line */
+struct StatusLineEntry {
+  int code;
+  std::string_view line;
+};
+
+/** Status codes of RFC 9110 section 15, plus the RFC 6585 / 7725 / 8297 additions */
+inline constexpr StatusLineEntry kStatusLineEntries[] = {
+  {100, "HTTP/1.1 100 Continue\r\n"},
+  {101, "HTTP/1.1 101 Switching Protocols\r\n"},
+  {103, "HTTP/1.1 103 Early Hints\r\n"},
+  {200, "HTTP/1.1 200 OK\r\n"},
+  {201, "HTTP/1.1 201 Created\r\n"},
+  {202, "HTTP/1.1 202 Accepted\r\n"},
+  {203, "HTTP/1.1 203 Non-Authoritative Information\r\n"},
+  {204, "HTTP/1.1 204 No Content\r\n"},
+  {205, "HTTP/1.1 205 Reset Content\r\n"},
+  {206, "HTTP/1.1 206 Partial Content\r\n"},
+  {300, "HTTP/1.1 300 Multiple Choices\r\n"},
+  {301, "HTTP/1.1 301 Moved Permanently\r\n"},
+  {302, "HTTP/1.1 302 Found\r\n"},
+  {303, "HTTP/1.1 303 See Other\r\n"},
+  {304, "HTTP/1.1 304 Not Modified\r\n"},
+  {305, "HTTP/1.1 305 Use Proxy\r\n"},
+  {307, "HTTP/1.1 307 Temporary Redirect\r\n"},
+  {308, "HTTP/1.1 308 Permanent Redirect\r\n"},
+  {400, "HTTP/1.1 400 Bad Request\r\n"},
+  {401, "HTTP/1.1 401 Unauthorized\r\n"},
+  {402, "HTTP/1.1 402 Payment Required\r\n"},
+  {403, "HTTP/1.1 403 Forbidden\r\n"},
+  {404, "HTTP/1.1 404 Not Found\r\n"},
+  {405, "HTTP/1.1 405 Method Not Allowed\r\n"},
+  {406, "HTTP/1.1 406 Not Acceptable\r\n"},
+  {407, "HTTP/1.1 407 Proxy Authentication Required\r\n"},
+  {408, "HTTP/1.1 408 Request Timeout\r\n"},
+  {409, "HTTP/1.1 409 Conflict\r\n"},
+  {410, "HTTP/1.1 410 Gone\r\n"},
+  {411, "HTTP/1.1 411 Length Required\r\n"},
+  {412, "HTTP/1.1 412 Precondition Failed\r\n"},
+  {413, "HTTP/1.1 413 Content Too Large\r\n"},
+  {414, "HTTP/1.1 414 URI Too Long\r\n"},
+  {415, "HTTP/1.1 415 Unsupported Media Type\r\n"},
+  {416, "HTTP/1.1 416 Range Not Satisfiable\r\n"},
+  {417, "HTTP/1.1 417 Expectation Failed\r\n"},
+  {421, "HTTP/1.1 421 Misdirected Request\r\n"},
+  {422, "HTTP/1.1 422 Unprocessable Content\r\n"},
+  {426, "HTTP/1.1 426 Upgrade Required\r\n"},
+  {428, "HTTP/1.1 428 Precondition Required\r\n"},
+  {429, "HTTP/1.1 429 Too Many Requests\r\n"},
+  {431, "HTTP/1.1 431 Request Header Fields Too Large\r\n"},
+  {451, "HTTP/1.1 451 Unavailable For Legal Reasons\r\n"},
+  {500, "HTTP/1.1 500 Internal Server Error\r\n"},
+  {501, "HTTP/1.1 501 Not Implemented\r\n"},
+  {502, "HTTP/1.1 502 Bad Gateway\r\n"},
+  {503, "HTTP/1.1 503 Service Unavailable\r\n"},
+  {504, "HTTP/1.1 504 Gateway Timeout\r\n"},
+  {505, "HTTP/1.1 505 HTTP Version Not Supported\r\n"},
+  {511, "HTTP/1.1 511 Network Authentication Required\r\n"},
+};
+
+/** Status lines indexed by code, empty for unregistered codes */
+inline constexpr auto kStatusLines = [] {
+  std::array<std::string_view, 600> table{};
+  for (const StatusLineEntry& entry : kStatusLineEntries) {
+    table[static_cast<size_t>(entry.code)] = entry.line;
+  }
+  return table;
+}();
+
+/** Length of the "HTTP/1.1 NNN " prefix of every status line */
+inline constexpr size_t kStatusTextOffset = 13;
+
+} // namespace detail
+
+/**
+ * @brief Get the pre-rendered status line of a status code
+ * @param code HTTP status code
+ * @return "HTTP/1.1 NNN Text\r\n", empty if the code is not registered
+ */
+constexpr std::string_view StatusLine(int code) {
+  if (code < 0 || code >= static_cast<int>(detail::kStatusLines.size())) {
+    return {};
+  }
+  return detail::kStatusLines[static_cast<size_t>(code)];
+}
+
+/**
+ * @brief Get the reason phrase of a status code
+ * @param code HTTP status code
+ * @return Reason phrase (e.g. "Not Found"), "Unknown" if the code is not registered
+ */
+constexpr std::string_view StatusText(int code) {
+  std::string_view line = StatusLine(code);
+  if (line.empty()) {
+    return "Unknown";
+  }
+  return line.substr(detail::kStatusTextOffset, line.size() - detail::kStatusTextOffset - 2);
+}
+
+static_assert(StatusLine(200) == "HTTP/1.1 200 OK\r\n");
+static_assert(StatusText(404) == "Not Found");
+
+} // namespace revak
@@ -0,0 +1,243 @@
+/**
+ * @file IoUring.h
+ * @brief IoUring class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace revak {
+
+/**
+ * @class IoUring
+ * @brief Minimal io_uring instance driven through the raw system calls
+ *
+ * Maps the submission and completion rings of one io_uring and offers the
+ * few operations the server needs: multishot accept, multishot recv into
+ * provided buffers, sendmsg and poll. Prepared entries are
+ * only handed to the kernel by Submit(), so one system call submits a whole
+ * batch and waits for completions. Not thread-safe: one thread owns a ring.
+ */
+class IoUring {
+public:
+  /**
+   * @brief Check once whether the kernel provides every feature the server uses
+   * @return true if rings, multishot operations and provided-buffer rings are available
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Create the ring and map its queues
+   * @param entries Submission queue size (rounded up to a power of two by the kernel)
+   */
+  explicit IoUring(unsigned entries);
+
+  /** Unmap the queues and close the ring, which cancels outstanding operations */
+  ~IoUring();
+
+  // Disable copy and assignment
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /** @return true if the ring was created and mapped */
+  bool IsValid() const { return ring_fd_ >= 0; }
+
+  /**
+   * @brief Provide equally sized receive buffers the kernel picks from
+   *
+   * Registers a provided-buffer ring, recycled without system calls. Some
+   * kernels accept the registration but never select from the ring, so it is
+   * checked with a test receive first; if that fails the buffers are handed
+   * over with IORING_OP_PROVIDE_BUFFERS instead. Call before anything else is
+   * submitted.
+   * @param group Buffer group id referenced by PrepareRecvMultishot()
+   * @param count Number of buffers (power of two, at most 32768)
+   * @param size Size of each buffer
+   * @return true if the buffers can be received into
+   */
+  bool SetupProvidedBuffers(uint16_t group, uint16_t count, uint32_t size);
+
+  /** @return true if the provided buffers live in a registered buffer ring */
+  bool UsesBufferRing() const { return buffer_ring_ != nullptr; }
+
+  /**
+   * @brief Get the memory of a provided buffer named by a completion
+   * @param id Buffer id, see BufferId()
+   * @return Start of the buffer
+   */
+  const char* Buffer(uint16_t id) const { return buffers_.get() + static_cast<size_t>(id) * buffer_size_; }
+
+  /**
+   * @brief Give a consumed buffer back to the kernel
+   * @param id Buffer id, see BufferId()
+   */
+  void RecycleBuffer(uint16_t id);
+
+  /** @return Buffer id carried by a completion with IORING_CQE_F_BUFFER set */
+  static uint16_t BufferId(const io_uring_cqe& cqe) { return static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT); }
+
+  /** @return true if the multishot operation of this completion stays armed */
+  static bool HasMore(const io_uring_cqe& cqe) { return (cqe.flags & IORING_CQE_F_MORE) != 0; }
+
+  /**
+   * @brief Accept connections until cancelled, one completion per client
+   * @param fd Listening socket
+   * @param user_data Value echoed in the completions
+   * @return false if the submission queue is full
+   */
+  bool PrepareAcceptMultishot(int fd, uint64_t user_data);
+
+  /**
+   * @brief Receive into buffers of a provided-buffer ring until the peer closes
+   * @param fd Connected socket
+   * @param group Buffer group id set up with SetupProvidedBuffers()
+   * @param user_data Value echoed in the completions
+   * @return false if the submission queue is full
+   */
+  bool PrepareRecvMultishot(int fd, uint16_t group, uint64_t user_data);
+
+  /**
+   * @brief Gathered send; the message and its buffers must stay valid until completion
+   * @param fd Connected socket
+   * @param message Message with the iovecs to send
+   * @param flags sendmsg() flags
+   * @param link Make the next prepared entry wait for this one (IOSQE_IO_LINK)
+   * @param user_data Value echoed in the completion
+   * @return false if the submission queue is full
+   */
+  bool PrepareSendmsg(int fd, const msghdr* message, unsigned flags, bool link, uint64_t user_data);
+
+  /**
+   * @brief Wait for poll events on a file descriptor
+   * @param fd File descriptor
+   * @param events poll() event mask
+   * @param multishot Keep reporting events until cancelled
+   * @param user_data Value echoed in the completions
+   * @return false if the submission queue is full
+   */
+  bool PreparePoll(int fd, uint32_t events, bool multishot, uint64_t user_data);
+
+  /**
+   * @brief Cancel the operation (or every shot of a multishot one) submitted with a user_data
+   * @param target user_data of the operation to cancel
+   * @param user_data Value echoed in the completion of the cancellation itself
+   * @return false if the submission queue is full
+   */
+  bool PrepareCancel(uint64_t target, uint64_t user_data);
+
+  /** @return Number of entries that can be prepared before the queue has to be flushed */
+  unsigned SpaceLeft() const;
+
+  /**
+   * @brief Hand every prepared entry to the kernel in one call
+   * @param wait_for Number of completions to wait for (0 returns at once)
+   * @return false on an unexpected io_uring_enter() error
+   */
+  bool Submit(unsigned wait_for);
+
+  /**
+   * @brief Consume every available completion
+   *
+   * The callback may prepare new entries; they are submitted by the next
+   * Submit().
+   * @param callback Invoked with a copy of each completion
+   * @return Number of completions consumed
+   */
+  template <typename Callback>
+  unsigned ForEachCompletion(Callback&& callback) {
+    unsigned head = *cq_head_;
+    unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+    unsigned count = 0;
+    while (head != tail) {
+      io_uring_cqe cqe = cqes_[head & cq_mask_];
+      // Release the slot before the callback, which may submit and produce more
+      std::atomic_ref<unsigned>(*cq_head_).store(++head, std::memory_order_release);
+      if (cqe.user_data != kInternalUserData && cqe.user_data != kTestUserData) {
+        callback(cqe);
+        ++count;
+      }
+    }
+    return count;
+  }
+
+private:
+  /** user_data of the ring's own operations, whose completions are not reported */
+  static constexpr uint64_t kInternalUserData = ~uint64_t{0};
+
+  /** user_data of the receive issued by TestReceive() */
+  static constexpr uint64_t kTestUserData = ~uint64_t{1};
+
+  /**
+   * @brief Register the buffer ring and check that a receive selects from it
+   * @param count Number of buffers
+   * @return true if the ring works
+   */
+  bool RegisterBufferRing(uint16_t count);
+
+  /**
+   * @brief Receive one pending byte into a provided buffer and wait for it
+   * @param fd Socket with one byte to read
+   * @return true if the byte arrived in a provided buffer
+   */
+  bool TestReceive(int fd);
+
+  /**
+   * @brief Hand buffers to the kernel with IORING_OP_PROVIDE_BUFFERS
+   * @param id First buffer id
+   * @param count Number of consecutive buffers
+   * @return false if the submission queue is full
+   */
+  bool ProvideBuffers(uint16_t id, uint16_t count);
+
+  /** @return A zeroed submission entry, flushing the queue if it is full; nullptr if it stays full */
+  io_uring_sqe* NextSqe();
+
+  /** io_uring file descriptor */
+  int ring_fd_{-1};
+
+  /** Mapped submission ring, completion ring (may be the same mapping) and entry array */
+  void* sq_ring_{nullptr};
+  void* cq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  size_t cq_ring_size_{0};
+  io_uring_sqe* sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  /** Submission ring fields shared with the kernel */
+  unsigned* sq_head_{nullptr};
+  unsigned* sq_tail_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned sq_entries_{0};
+
+  /** Tail including entries prepared but not published yet */
+  unsigned sqe_tail_{0};
+
+  /** Completion ring fields shared with the kernel */
+  unsigned* cq_head_{nullptr};
+  unsigned* cq_tail_{nullptr};
+  unsigned cq_mask_{0};
+  io_uring_cqe* cqes_{nullptr};
+
+  /** Provided-buffer ring shared with the kernel, nullptr with IORING_OP_PROVIDE_BUFFERS */
+  io_uring_buf_ring* buffer_ring_{nullptr};
+  size_t buffer_ring_size_{0};
+  uint16_t buffer_mask_{0};
+  uint16_t buffer_tail_{0};
+
+  /** Memory of the provided buffers */
+  std::unique_ptr<char[]> buffers_;
+  uint32_t buffer_size_{0};
+  uint16_t buffer_group_{0};
+};
+
+} // namespace revak
@@ -1,7 +1,7 @@
 /**
  * @file Logger.h
  * @brief Logger class declaration
- * 
+ *
  * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
  * Licensed under the MIT License. Part of the Revak project.
  */
@@ -9,18 +9,48 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <format>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 #include <thread>
 #include <atomic>
 #include <condition_variable>
 
+/**
+ * Lowest level compiled into REVAK_LOG calls (0 DEBUG, 1 INFO, 2 WARNING, 3 ERROR).
+ * Calls below it are discarded at compile time, arguments included.
+ */
+#ifndef REVAK_LOG_MIN_LEVEL
+#define REVAK_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Log a std::format message if its level is compiled in and enabled
+ *
+ * The arguments are neither evaluated nor formatted when the level is off.
+ * Example: REVAK_LOG(DEBUG, "Handled {} {}", req.Method(), req.Path());
+ */
+#define REVAK_LOG(level, ...)                                                                  \
+  do {                                                                                         \
+    if constexpr (static_cast<int>(::revak::Logger::Level::level) >= REVAK_LOG_MIN_LEVEL) {    \
+      if (::revak::Logger::Instance().IsEnabled(::revak::Logger::Level::level)) {              \
+        ::revak::Logger::Instance().Log(::revak::Logger::Level::level, std::format(__VA_ARGS__)); \
+      }                                                                                        \
+    }                                                                                          \
+  } while (0)
+
 namespace revak {
 
 /**
  * @class Logger
  * @brief Singleton Logger class for logging messages with different severity levels
+ *
+ * Every logging thread writes into its own lock-free ring buffer; a
+ * background thread drains the rings, formats the lines and writes them
+ * in batches. A full ring drops the message instead of blocking the
+ * caller, and the drop is counted and reported.
  */
 class Logger {
 public:
@@ -29,44 +59,85 @@ public:
    * @return Reference to the Logger instance
    */
   static Logger& Instance();
-  
+
   // Disable copy and assignment
   Logger(const Logger&) = delete;
   Logger& operator=(const Logger&) = delete;
 
   /** Log levels */
   enum class Level {
+    DEBUG,
     INFO,
     WARNING,
     ERROR
   };
 
-  /** 
+  /**
    * @brief Log a message with the specified level
-   * @param level Log level (INFO, WARNING, ERROR)
+   * @param level Log level (DEBUG, INFO, WARNING, ERROR)
    * @param message Message to log
    */
-  void Log(Level level, const std::string& message);
+  void Log(Level level, std::string_view message);
+
+  /**
+   * @brief Set the lowest level that is logged (default is INFO)
+   * @param level Minimum log level
+   */
+  void SetLevel(Level level) { min_level_.store(level, std::memory_order_relaxed); }
+
+  /** @return true if messages of this level are logged */
+  bool IsEnabled(Level level) const { return level >= min_level_.load(std::memory_order_relaxed); }
+
+  /** @return Number of messages dropped because a ring buffer was full */
+  uint64_t DroppedMessages() const;
 
 private:
+  /** Per-thread ring buffer, defined in Logger.cc */
+  struct Ring;
+
+  /** Thread-local handle that orphans the ring when its thread exits */
+  struct ThreadRing;
+
   /** Private constructor for singleton pattern */
   Logger();
   ~Logger();
 
-  /** Mutex for thread-safe logging */
-  std::mutex queue_mutex_;
+  /** @return Ring buffer of the calling thread, registered on first use */
+  Ring& LocalRing();
 
-  /** Thread for asynchronous logging */
-  std::thread log_thread_;
+  /**
+   * @brief Move every buffered message into the output batch
+   * @param batch Output batch to append formatted lines to
+   * @return true if any message was drained
+   */
+  bool Drain(std::string& batch);
+
+  /** Write the batch to standard output and clear it */
+  static void WriteBatch(std::string& batch);
+
+  /** Lowest level that is logged */
+  std::atomic<Level> min_level_{Level::INFO};
+
+  /** Mutex for the ring registry (taken once per thread, and by the log thread) */
+  mutable std::mutex rings_mutex_;
 
-  /** Queue for log messages */
-  std::queue<std::string> log_queue_;
+  /** Rings of every thread that logged, kept until drained after the thread exits */
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  /** Drops counted on rings that were already released, updated and read under rings_mutex_ */
+  std::atomic<uint64_t> retired_drops_{0};
+
+  /** Mutex paired with the log condition, only used to sleep between drains */
+  std::mutex wait_mutex_;
+
+  /** Condition variable used to wake the log thread early */
+  std::condition_variable log_condition_;
 
   /** Atomic variable for stopping logging */
   std::atomic<bool> stop_logging_{false};
 
-  /** Condition variable for log notification */
-  std::condition_variable log_condition_;
+  /** Thread for asynchronous logging */
+  std::thread log_thread_;
 };
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
@@ -0,0 +1,123 @@
+/**
+ * @file Metrics.h
+ * @brief Metrics class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "Histogram.h"
+#include "Router.h"
+#include "ThreadPool.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class Metrics
+ * @brief Request, latency and connection metrics kept in per-thread shards
+ *
+ * Every recording thread writes only to its own shard, registered on its
+ * first call; recording is a handful of relaxed single-writer stores, with
+ * no lock and no read-modify-write. A reader (the /metrics route) adds the
+ * shards together and renders them in the Prometheus text format. Requests
+ * are keyed by the id of the route the Router matched; those no route
+ * matched (404, 405) are counted together.
+ */
+class Metrics {
+public:
+  /** Most routes counted separately; requests of later routes count as unmatched */
+  static constexpr size_t kMaxRoutes = 16384;
+
+  Metrics();
+  ~Metrics();
+
+  // Disable copy and assignment
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+
+  /**
+   * @brief Count a handled request
+   * @param route_id Route the request matched, Request::kNoRoute if none
+   * @param status HTTP status code of the response
+   * @param duration_ns Time spent producing the response
+   */
+  void RecordRequest(size_t route_id, int status, uint64_t duration_ns);
+
+  /** Count an accepted connection */
+  void ConnectionOpened();
+
+  /** Count a closed connection */
+  void ConnectionClosed();
+
+  /** Count a request answered 503 by admission control instead of its handler */
+  void RequestShed();
+
+  /**
+   * @brief Render every metric in the Prometheus text exposition format
+   * @param router Router whose route ids were recorded, names the routes
+   * @param pool Thread pool statistics to include
+   * @return Text for a "text/plain; version=0.0.4" response
+   */
+  std::string Render(const Router& router, const ThreadPool::Stats& pool) const;
+
+private:
+  /** Counters of one route on one thread */
+  struct RouteStats {
+    /** Responses by status class, 1xx to 5xx */
+    std::array<std::atomic<uint64_t>, 5> status_classes{};
+
+    Histogram latency;
+  };
+
+  /** Routes are allocated in chunks as the thread first meets them */
+  static constexpr size_t kRoutesPerChunk = 16;
+  static constexpr size_t kChunks = kMaxRoutes / kRoutesPerChunk;
+
+  struct RouteChunk {
+    std::array<RouteStats, kRoutesPerChunk> routes;
+  };
+
+  /** Everything one thread records */
+  struct Shard {
+    ~Shard();
+
+    /** Published with a release store by the owning thread, nullptr until used */
+    std::array<std::atomic<RouteChunk*>, kChunks> chunks{};
+
+    /** Requests no route matched */
+    RouteStats unmatched;
+
+    std::atomic<uint64_t> connections_opened{0};
+    std::atomic<uint64_t> connections_closed{0};
+    std::atomic<uint64_t> requests_shed{0};
+  };
+
+  /** @return Shard of the calling thread, registered on first use */
+  Shard& LocalShard();
+
+  /** @return Counters of a route in a shard, allocating its chunk if needed (owning thread only) */
+  static RouteStats& LocalRoute(Shard& shard, size_t route_id);
+
+  /** Distinguishes instances in the thread-local shard cache */
+  const uint64_t instance_id_;
+
+  /** Guards the shard registry (taken once per thread, and by Render()) */
+  mutable std::mutex shards_mutex_;
+
+  /** Shards by thread; kept after a thread exits so its counts survive */
+  std::vector<std::pair<std::thread::id, std::unique_ptr<Shard>>> shards_;
+};
+
+} // namespace revak
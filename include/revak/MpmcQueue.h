@@ -0,0 +1,129 @@
+/**
+ * @file MpmcQueue.h
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace revak {
+
+/**
+ * @class MpmcQueue
+ * @brief Bounded lock-free MPMC ring (Dmitry Vyukov's sequence-per-cell design)
+ *
+ * Each cell carries a sequence number telling producers and consumers
+ * whether it is free or full for the current lap, so a push or pop costs
+ * one CAS on the shared index and touches no lock.
+ * @tparam T Element type, must be movable
+ */
+template <typename T>
+class MpmcQueue {
+public:
+  /**
+   * @brief Create an empty queue
+   * @param capacity Number of cells, must be a power of two
+   */
+  explicit MpmcQueue(size_t capacity)
+    : mask_(capacity - 1), cells_(new Cell[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Disable copy and assignment
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  /**
+   * @brief Append an element
+   * @param value Element to append, left untouched when the queue is full
+   * @return true if appended, false if the queue is full
+   */
+  bool TryPush(T& value) {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[position & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (diff == 0) {
+        if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false; // Full
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest element
+   * @return Element, std::nullopt if the queue is empty
+   */
+  std::optional<T> TryPop() {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[position & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (diff == 0) {
+        if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return std::nullopt; // Empty
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    std::optional<T> value(std::move(cell->value));
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return value;
+  }
+
+  /** @return Approximate number of queued elements */
+  size_t SizeApprox() const {
+    size_t enqueued = enqueue_position_.load(std::memory_order_relaxed);
+    size_t dequeued = dequeue_position_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  /** @return Number of cells */
+  size_t Capacity() const { return mask_ + 1; }
+
+private:
+  /** One slot with its lap sequence number */
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  /** Capacity minus one, for index wrapping */
+  size_t mask_;
+
+  /** Cell storage */
+  std::unique_ptr<Cell[]> cells_;
+
+  /** Next cell to fill */
+  alignas(64) std::atomic<size_t> enqueue_position_{0};
+
+  /** Next cell to drain */
+  alignas(64) std::atomic<size_t> dequeue_position_{0};
+};
+
+} // namespace revak
@@ -8,21 +8,54 @@
 
 #pragma once
 
-#include <string>
+#include "HttpHeader.h"
+#include "HttpMethod.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string_view>
-#include <map>
+#include <vector>
 
 namespace revak {
 
+/**
+ * @struct RequestHeader
+ * @brief A header field of a Request, viewing the connection buffer
+ */
+struct RequestHeader {
+  std::string_view name;
+  std::string_view value;
+};
+
+/**
+ * @struct RouteParam
+ * @brief A path parameter captured by the Router (":name" or "*name" segment)
+ */
+struct RouteParam {
+  std::string_view name;
+  std::string_view value;
+};
+
 /**
  * @class Request
  * @brief Represents an HTTP request with method, path, headers, and body
+ *
+ * A Request does not own its bytes: every field is a view into the buffer
+ * the request was parsed from (the connection's input buffer when served by
+ * Server). The buffer must outlive the Request, so handlers that keep data
+ * beyond their own call must copy it.
  */
 class Request {
 public:
+  /** Construct an empty Request (filled by RequestParser) */
+  Request() = default;
+
   /** 
    * @brief Construct a Request object from a raw request string
-   * @param request Raw HTTP request string
+   *
+   * Fields stay empty if the string does not hold a complete, valid request.
+   * @param request Raw HTTP request string, must outlive the Request
    */
   explicit
   Request(const std::string_view& request);
@@ -31,32 +64,163 @@ public:
    * @brief Get the HTTP method of the request
    * @return HTTP method as a string
    */
-  const std::string& Method() const {return method_;}
+  std::string_view Method() const {return method_;}
+
+  /**
+   * @brief Get the HTTP method of the request, recognised by the parser
+   * @return Method, HttpMethod::OTHER if it is not a known one (see Method() for its text)
+   */
+  HttpMethod MethodId() const {return method_id_;}
 
   /**
    * @brief Get the path of the request
    * @return Request path as a string
    */
-  const std::string& Path() const {return path_;}
+  std::string_view Path() const {return path_;}
 
   /**
    * @brief Get the Body of the request
    * @return Request body as a string
    */
-  const std::string& Body() const {return body_;}
+  std::string_view Body() const {return body_;}
+
+  /**
+   * @brief Get the protocol version of the request
+   * @return Version token from the request line (e.g. "HTTP/1.1")
+   */
+  std::string_view Version() const {return version_;}
+
+  /**
+   * @brief Get the value of a request header
+   *
+   * Well-known names are looked up as with Header(HttpHeader), others by
+   * a scan of the headers.
+   * @param name Header name, compared case-insensitively
+   * @return Value of the first matching header, empty if not present
+   */
+  std::string_view Header(std::string_view name) const;
+
+  /**
+   * @brief Get the value of a well-known request header, from the slot the parser filled
+   * @param header A well-known header
+   * @return Value of the first such header, empty if not present or for HttpHeader::OTHER
+   */
+  std::string_view Header(HttpHeader header) const {
+    size_t index = static_cast<size_t>(header);
+    uint32_t slot = index < kKnownHeaders ? header_slots_[index] : kNoHeader;
+    return slot == kNoHeader ? std::string_view() : Headers()[slot].value;
+  }
+
+  /**
+   * @brief Get all request headers in arrival order
+   * @return Header fields
+   */
+  std::span<const RequestHeader> Headers() const;
+
+  /**
+   * @brief Get a path parameter captured by the matched route
+   * @param name Parameter name without the ':' or '*' prefix
+   * @return Parameter value, empty if the route has no such parameter
+   */
+  std::string_view Param(std::string_view name) const;
+
+  /**
+   * @brief Get all path parameters of the matched route
+   * @return Captured parameters, in path order
+   */
+  std::span<const RouteParam> Params() const { return {params_.data(), param_count_}; }
+
+  /**
+   * @brief Check if the client wants the connection to stay open
+   *
+   * HTTP/1.1 connections are persistent unless the client sends
+   * "Connection: close"; HTTP/1.0 ones only with "Connection: keep-alive".
+   * @return true if the connection may serve further requests
+   */
+  bool KeepAlive() const;
+
+  /**
+   * @brief Check an entity tag against the If-None-Match header
+   *
+   * Uses the weak comparison RFC 9110 requires for If-None-Match, so
+   * W/"x" matches "x"; "*" matches any tag.
+   * @param etag Current entity tag of the resource, quotes included
+   * @return true if the header lists the tag, false if it does not or is absent
+   */
+  bool MatchesEtag(std::string_view etag) const;
+
+  /**
+   * @brief Get the route the Router matched
+   * @return Route id (see Router::GetRoute()), kNoRoute if no route matched
+   */
+  size_t RouteId() const { return route_id_; }
+
+  /** Most path parameters a route may declare */
+  static constexpr size_t kMaxParams = 8;
+
+  /** RouteId() of a request no route matched */
+  static constexpr size_t kNoRoute = static_cast<size_t>(-1);
 
 private:
+  friend class RequestParser;
+  friend class Router;
+
+  /** Headers stored inline before spilling to the heap */
+  static constexpr size_t kInlineHeaders = 16;
+
+  /** Header slot of a well-known header the request does not have */
+  static constexpr uint32_t kNoHeader = UINT32_MAX;
+
+  /**
+   * @brief Append a header field
+   * @param name Header name
+   * @param value Header value
+   * @param header Well-known header the name is, HttpHeader::OTHER if none
+   */
+  void AddHeader(std::string_view name, std::string_view value, HttpHeader header);
+
+  /** Forget the headers, keeping the spilled ones' capacity */
+  void ClearHeaders();
+
   /** HTTP method of the request */
-  std::string method_;
+  std::string_view method_;
+
+  /** Recognised HTTP method */
+  HttpMethod method_id_{HttpMethod::OTHER};
 
   /** Path of the request */
-  std::string path_;
+  std::string_view path_;
 
-  /** Map of header key-value pairs */
-  std::map<std::string, std::string> headers_;
+  /** Protocol version of the request */
+  std::string_view version_;
 
   /** Body content of the request */
-  std::string body_;
+  std::string_view body_;
+
+  /** Number of header fields */
+  size_t header_count_{0};
+
+  /** Header fields while there are at most kInlineHeaders of them */
+  std::array<RequestHeader, kInlineHeaders> inline_headers_{};
+
+  /** All header fields once there are more than kInlineHeaders */
+  std::vector<RequestHeader> spilled_headers_;
+
+  /** Index of the first header of each well-known name, kNoHeader if absent */
+  std::array<uint32_t, kKnownHeaders> header_slots_ = [] {
+    std::array<uint32_t, kKnownHeaders> slots{};
+    slots.fill(kNoHeader);
+    return slots;
+  }();
+
+  /** Number of captured path parameters */
+  size_t param_count_{0};
+
+  /** Path parameters captured by the Router */
+  std::array<RouteParam, kMaxParams> params_{};
+
+  /** Route matched by the Router */
+  size_t route_id_{kNoRoute};
 };
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
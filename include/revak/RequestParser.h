@@ -0,0 +1,171 @@
+/**
+ * @file RequestParser.h
+ * @brief RequestParser class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "HeaderScanner.h"
+#include "Request.h"
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class RequestParser
+ * @brief Incremental, resumable HTTP/1.1 request parser
+ *
+ * The caller keeps the received bytes of the current request in one buffer
+ * and calls Parse() again each time the buffer grows. The parser remembers
+ * how far it got, so every byte is examined once no matter how the request
+ * was split across reads. Positions are kept as offsets rather than
+ * pointers, which keeps them valid when the caller's buffer reallocates.
+ */
+class RequestParser {
+public:
+  /** Outcome of a Parse() call */
+  enum class Result {
+    NEED_MORE,  ///< The request is incomplete, call Parse() again with more bytes
+    COMPLETE,   ///< A full request (headers and body) is available
+    ERROR       ///< The request is malformed or too large, see ErrorStatus()
+  };
+
+  /** Size limits enforced while parsing */
+  struct Limits {
+    /** Largest request line plus header block, answered with 431 when exceeded */
+    size_t max_header_size = 16384;
+
+    /** Largest Content-Length accepted, answered with 413 when exceeded */
+    size_t max_body_size = 1024 * 1024;
+  };
+
+  /** Create a parser with the default limits */
+  RequestParser() = default;
+
+  /**
+   * @brief Create a parser with custom limits
+   * @param limits Header and body size limits
+   */
+  explicit RequestParser(Limits limits) : limits_(limits) {}
+
+  /**
+   * @brief Continue parsing the current request
+   * @param data All bytes received for the current request so far; each call
+   *        must pass the same prefix as the previous one, possibly extended
+   * @return Parse result
+   */
+  Result Parse(std::string_view data);
+
+  /**
+   * @brief Point a request at the parsed fields, without copying them
+   * @param data Same buffer passed to the Parse() call that returned COMPLETE;
+   *        it must outlive the request
+   * @param request Request to fill
+   */
+  void Fill(std::string_view data, Request& request) const;
+
+  /** @return Number of bytes taken by the completed request */
+  size_t RequestSize() const { return body_start_ + content_length_; }
+
+  /** @return true once the current request's headers are parsed and its body is awaited */
+  bool InBody() const { return state_ == State::BODY; }
+
+  /** @return HTTP status describing the error (400, 413, 431 or 501) */
+  int ErrorStatus() const { return error_status_; }
+
+  /** Prepare the parser for the next request on the connection */
+  void Reset();
+
+private:
+  /** Byte range inside the parsed buffer */
+  struct Span {
+    size_t offset{0};
+    size_t length{0};
+  };
+
+  /** Header name and value ranges, with the well-known header the name is */
+  struct Field {
+    Span name;
+    Span value;
+    HttpHeader header;
+  };
+
+  /** Parser position inside the request */
+  enum class State {
+    REQUEST_LINE,
+    HEADERS,
+    BODY,
+    COMPLETE,
+    ERROR
+  };
+
+  /**
+   * @brief Parse "METHOD SP target SP HTTP/x.y"
+   * @param line Line contents without the line ending
+   * @param offset Offset of the line inside the buffer
+   * @return true if the line is well formed
+   */
+  bool ParseRequestLine(std::string_view line, size_t offset);
+
+  /**
+   * @brief Parse "name: value" and interpret the framing headers
+   * @param line Line contents without the line ending
+   * @param offset Offset of the line inside the buffer
+   * @param colon Position of the first colon in the line, the name before it
+   *        already checked to be a token by the scanner
+   * @return true if the line is acceptable
+   */
+  bool ParseHeaderLine(std::string_view line, size_t offset, size_t colon);
+
+  /**
+   * @brief Enter the error state
+   * @param status HTTP status to answer with
+   * @return Result::ERROR
+   */
+  Result Fail(int status);
+
+  /** Size limits */
+  Limits limits_;
+
+  /** Current state */
+  State state_{State::REQUEST_LINE};
+
+  /** Offset of the first byte of the current line */
+  size_t line_start_{0};
+
+  /** Offset where the search for the next line ending resumes */
+  size_t scan_position_{0};
+
+  /** Line feed, colon and name validity of the line being scanned */
+  HeaderScanner scanner_;
+
+  /** Offset of the first body byte */
+  size_t body_start_{0};
+
+  /** Declared body length */
+  size_t content_length_{0};
+
+  /** True once a Content-Length header was seen */
+  bool has_content_length_{false};
+
+  /** HTTP status of the parse error */
+  int error_status_{0};
+
+  /** Request line fields */
+  Span method_, path_, version_;
+
+  /** Recognised method of the request line */
+  HttpMethod method_id_{HttpMethod::OTHER};
+
+  /** Header fields, in arrival order */
+  std::vector<Field> headers_;
+};
+
+} // namespace revak
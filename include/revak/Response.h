@@ -8,14 +8,53 @@
 
 #pragma once
 
+#include "Arena.h"
+#include "FileHandle.h"
+#include "HttpHeader.h"
+
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace revak {
 
+/**
+ * @struct FileRegion
+ * @brief A byte range of an open file, sent with sendfile(2) instead of being read into memory
+ */
+struct FileRegion {
+  /** Open file, shared so responses and caches can hold it independently */
+  std::shared_ptr<const FileHandle> file;
+
+  /** Offset of the first byte to send */
+  uint64_t offset{0};
+
+  /** Number of bytes to send */
+  size_t length{0};
+};
+
+/**
+ * @typedef BodyStream
+ * @brief Produces a streamed body piece by piece
+ *
+ * Called each time the previous piece has been sent: append the next data
+ * to chunk and return true, or append the last data (possibly none) and
+ * return false.
+ */
+using BodyStream = std::function<bool(std::string& chunk)>;
+
 /**
  * @class Response
  * @brief Represents a response with status code, headers, and body content
+ *
+ * Headers are allocated from the CurrentMemoryResource() at construction:
+ * the arena of the connection when the response is built by a handler the
+ * server dispatched, so it must not outlive that request.
  */
 class Response {
 public:
@@ -37,11 +76,18 @@ public:
   void SetStatus(int code);
 
   /**
-   * @brief Set a header key-value pair
+   * @brief Set a header key-value pair, replacing a header of the same name in any case
    * @param key Header key
    * @param value Header value
    */
-  void SetHeader(std::string key, std::string value);
+  void SetHeader(std::string_view key, std::string_view value);
+
+  /**
+   * @brief Get the value of a header set on the response
+   * @param key Header key, compared case-insensitively
+   * @return Header value, empty if the header is not set
+   */
+  std::string_view GetHeader(std::string_view key) const;
 
   /**
    * @brief Set the body content of the response
@@ -49,12 +95,103 @@ public:
    */
   void SetBody(std::string content);
 
+  /**
+   * @brief Send part of an immutable buffer as the body, without copying it
+   * @param buffer Shared buffer, kept alive until the response is sent
+   * @param offset Offset of the first body byte in the buffer
+   * @param length Number of body bytes, the rest of the buffer by default
+   */
+  void SetSharedBody(std::shared_ptr<const std::string> buffer, size_t offset = 0, size_t length = std::string::npos);
+
+  /**
+   * @brief Send header lines and body serialized ahead of time, without copying them
+   *
+   * The buffer holds header lines as SerializeHeaders() writes them, the
+   * empty line and the body, as ResponseCache keeps them. SerializeHead()
+   * then writes only the status line, Server, Date and the headers set with
+   * SetHeader(); the buffer follows as is and is what GetBody() returns.
+   * @param buffer Shared buffer, kept alive until the response is sent
+   */
+  void SetSerialized(std::shared_ptr<const std::string> buffer);
+
+  /**
+   * @brief Send a file region as the body with sendfile(2)
+   * @param region File region to send
+   */
+  void SetFileBody(FileRegion region);
+
+  /**
+   * @brief Stream the body as it is produced, with chunked transfer encoding
+   *
+   * The stream is only asked for more data once the previous chunk is
+   * written to the socket, so a slow client slows the producer down
+   * instead of growing a buffer. Consecutive small pieces are gathered
+   * into chunks of at least 16 KiB.
+   * @code
+   * res.SetStreamBody([i = 0](std::string& chunk) mutable {
+   *   chunk += std::format("line {}\n", i);
+   *   return ++i < 1000;
+   * });
+   * @endcode
+   * @param stream Producer of the body pieces
+   */
+  void SetStreamBody(BodyStream stream);
+
+  /**
+   * @brief Choose whether a streamed body is framed with chunked encoding (default)
+   *
+   * Without it the end of the body is signalled by closing the connection,
+   * which is what HTTP/1.0 clients expect.
+   * @param enabled true to use chunked transfer encoding
+   */
+  void SetChunkedEncoding(bool enabled) { chunked_ = enabled; }
+
+  /** @return true if the body is streamed */
+  bool IsStreamed() const { return static_cast<bool>(stream_body_); }
+
+  /** @return true if a streamed body is sent with chunked transfer encoding */
+  bool IsChunked() const { return stream_body_ && chunked_ && !has_content_length_; }
+
+  /**
+   * @brief Pull the next piece of a streamed body
+   * @param chunk Buffer the piece is appended to
+   * @return false once the last piece was produced
+   */
+  bool NextChunk(std::string& chunk) { return stream_body_(chunk); }
+
+  /**
+   * @brief Get the in-memory body content of the response
+   * @return Body content, empty for a file or streamed body
+   */
+  std::string_view GetBody() const;
+
+  /** @return File body of the response, nullptr if the body is in memory */
+  const FileRegion* GetFileBody() const { return file_body_ ? &*file_body_ : nullptr; }
+
+  /** @return Number of body bytes, whichever way the body is stored */
+  size_t BodySize() const { return file_body_ ? file_body_->length : GetBody().size(); }
+
   /**
    * @brief Convert the response to a raw HTTP response string
+   *
+   * Copies the body; the server sends SerializeHead() and the body as
+   * separate buffers instead. File and streamed bodies are not included.
    * @return Raw HTTP response as a string
    */
   std::string ToString() const;
 
+  /**
+   * @brief Append the status line and header block, including the empty line ending it
+   * @param out Buffer to append to; reusing one buffer across responses avoids allocations
+   */
+  void SerializeHead(std::string& out) const;
+
+  /**
+   * @brief Append the header lines after Date: the framing header and those set with SetHeader()
+   * @param out Buffer to append to
+   */
+  void SerializeHeaders(std::string& out) const;
+
   /**
    * @brief Get the status code of the response
    * @return Status code as an integer
@@ -63,20 +200,41 @@ public:
 
   /**
    * @brief Get the status text corresponding to the status code
-   * @return Status text as a string
+   * @return Status text, pointing into a static table
    */
-  std::string GetStatusText() const;
+  std::string_view GetStatusText() const;
   
 private:
 
   /** Status code of the response */
   int status_code_{200};
 
-  /** Map to store header key-value pairs */
-  std::map<std::string, std::string> headers_;
+  /** Map to store header key-value pairs, names compared case-insensitively */
+  std::pmr::map<std::pmr::string, std::pmr::string, detail::HeaderNameLess> headers_{CurrentMemoryResource()};
+
+  /** A Content-Length header was set, in whatever case: the body is not framed again */
+  bool has_content_length_{false};
 
   /** Body content of the response */
   std::string body_;
+
+  /** Shared buffer holding the body, body_ is unused when set */
+  std::shared_ptr<const std::string> shared_body_;
+
+  /** Body bytes inside shared_body_ */
+  std::string_view shared_view_;
+
+  /** shared_body_ starts with serialized header lines, see SetSerialized() */
+  bool serialized_{false};
+
+  /** File region sent as the body */
+  std::optional<FileRegion> file_body_;
+
+  /** Producer of a streamed body */
+  BodyStream stream_body_;
+
+  /** Frame a streamed body with chunked transfer encoding */
+  bool chunked_{true};
 };
 
 } // namespace revak
\ No newline at end of file
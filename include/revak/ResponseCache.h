@@ -0,0 +1,154 @@
+/**
+ * @file ResponseCache.h
+ * @brief ResponseCache class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "Handler.h"
+#include "Request.h"
+#include "Response.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @struct CacheOptions
+ * @brief Caching of one route's responses
+ */
+struct CacheOptions {
+  /** How long a response is served from the cache before the handler runs again */
+  std::chrono::milliseconds ttl{60000};
+
+  /** Request headers whose values select different responses (sent back as Vary) */
+  std::vector<std::string> vary{};
+};
+
+/**
+ * @class ResponseCache
+ * @brief Byte-bounded LRU cache of serialized GET responses, with TTL and ETags
+ *
+ * Responses are keyed by method, request target and the values of the
+ * route's vary headers. A cached response is kept fully serialized (header
+ * lines and body) in an immutable buffer that every hit sends without
+ * copying, so a hit runs neither the handler nor the serializer; only the
+ * status line, Date and Connection are written per response. Responses get
+ * an ETag from a hash of their body unless the handler set one, and
+ * If-None-Match is answered with 304.
+ *
+ * Only 200 responses with an in-memory body are stored; those setting
+ * cookies, a Connection header or "Cache-Control: no-store" are passed
+ * through. Entries are spread over kShards independently locked shards,
+ * each with its own LRU list and an equal share of the byte budget, which
+ * also bounds a single entry: responses larger than max_bytes / kShards
+ * (4 MiB of the default 64 MiB) are served but not cached, and the first
+ * one refused is logged.
+ */
+class ResponseCache {
+public:
+  /** Independently locked parts of the cache */
+  static constexpr size_t kShards = 16;
+
+  /**
+   * @brief Create an empty cache
+   * @param max_bytes Total size of the cached responses
+   */
+  explicit ResponseCache(size_t max_bytes = 64 * 1024 * 1024);
+
+  // Disable copy and assignment
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+
+  /**
+   * @brief Answer a request from the cache, running the handler on a miss
+   * @param request Request matched by the cached route
+   * @param handler Handler of the route
+   * @param options Caching of the route
+   * @return Cached response, 304 if the client's ETag matches, or the handler's uncacheable response
+   */
+  Response Serve(const Request& request, const Handler& handler, const CacheOptions& options);
+
+  /**
+   * @brief Change the total size of the cached responses, evicting as needed
+   * @param max_bytes Size in bytes, a kShards-th of it bounding a single response
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  /** Drop every cached response */
+  void Clear();
+
+private:
+  /** A cached response */
+  struct Entry;
+
+  /** One lock's worth of entries */
+  struct Shard {
+    std::mutex mutex;
+
+    /** Entries, most recently used first */
+    std::list<std::shared_ptr<const Entry>> lru;
+
+    /** Entries by key; the keys view the entries' own copies */
+    std::unordered_map<std::string_view, std::list<std::shared_ptr<const Entry>>::iterator> index;
+
+    /** Size of the entries and the share of the budget */
+    size_t bytes{0};
+    size_t max_bytes{0};
+  };
+
+  /**
+   * @brief Find a live entry and mark it most recently used
+   * @param shard Shard of the key
+   * @param key Cache key
+   * @return Entry, nullptr if absent or expired
+   */
+  static std::shared_ptr<const Entry> Find(Shard& shard, std::string_view key);
+
+  /**
+   * @brief Add an entry, replacing one with the same key and evicting the least recently used
+   * @param shard Shard of the key
+   * @param entry Entry to add
+   * @return false if the entry is larger than the shard's whole share and was not added
+   */
+  static bool Insert(Shard& shard, std::shared_ptr<const Entry> entry);
+
+  /**
+   * @brief Remove an entry (shard mutex held)
+   * @param shard Shard holding the entry
+   * @param position Entry's position in the LRU list
+   */
+  static void Erase(Shard& shard, std::list<std::shared_ptr<const Entry>>::iterator position);
+
+  /**
+   * @brief Serialize a handler's response into a new entry
+   * @param key Cache key
+   * @param response Response of the handler, receives ETag and Vary headers
+   * @param options Caching of the route
+   * @return Entry, nullptr if the response must not be cached
+   */
+  static std::shared_ptr<const Entry> MakeEntry(std::string_view key, Response& response, const CacheOptions& options);
+
+  std::array<Shard, kShards> shards_;
+
+  /** Share of the budget of each shard, the largest entry kept */
+  std::atomic<size_t> shard_max_bytes_{0};
+
+  /** Set once a response too large to cache was logged */
+  std::atomic<bool> oversize_reported_{false};
+};
+
+} // namespace revak
@@ -0,0 +1,373 @@
+/**
+ * @file RouteTable.h
+ * @brief RouteTable class template declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "HttpMethod.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace revak {
+
+class Request;
+class Response;
+
+/**
+ * @struct StaticRoute
+ * @brief A route known at compile time: an exact path and a plain function
+ */
+struct StaticRoute {
+  std::string_view method;
+  std::string_view path;
+
+  /** Called directly, a captureless lambda converts to it */
+  Response (*handler)(const Request&);
+};
+
+namespace detail {
+
+/** Multiplier of the path hash, the 64-bit golden ratio */
+constexpr uint64_t kRouteHashMultiplier = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Hash a path eight bytes at a time, the same at compile time and at runtime
+ * @param path Path without the query string
+ * @return 64-bit hash, spread into table slots by RouteSlotHash()
+ */
+constexpr uint64_t RoutePathHash(std::string_view path) {
+  uint64_t hash = path.size() * kRouteHashMultiplier;
+  size_t i = 0;
+  for (; i + 8 <= path.size(); i += 8) {
+    uint64_t word = 0;
+    for (size_t b = 0; b < 8; ++b) {
+      word |= uint64_t{static_cast<unsigned char>(path[i + b])} << (8 * b);
+    }
+    hash = (hash ^ word) * kRouteHashMultiplier;
+    hash ^= hash >> 29;
+  }
+  uint64_t tail = 0;
+  for (size_t b = 0; i + b < path.size(); ++b) {
+    tail |= uint64_t{static_cast<unsigned char>(path[i + b])} << (8 * b);
+  }
+  return (hash ^ tail) * kRouteHashMultiplier;
+}
+
+/**
+ * @brief Second-level hash: the path hash displaced by its bucket's seed (murmur3 finalizer)
+ * @param hash RoutePathHash() of the path
+ * @param seed Seed of the path's bucket
+ * @return Hash whose low bits pick the slot
+ */
+constexpr uint64_t RouteSlotHash(uint64_t hash, uint32_t seed) {
+  hash ^= seed * kRouteHashMultiplier;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+} // namespace detail
+
+/**
+ * @class RouteTableView
+ * @brief Lookup over the arrays of a RouteTable, independent of its size
+ *
+ * What Router holds of a RouteTable; the table must outlive it, which a
+ * constexpr table at namespace scope does.
+ */
+class RouteTableView {
+public:
+  /**
+   * @struct Path
+   * @brief One distinct path of the table and its routes, one per method
+   */
+  struct Path {
+    std::string_view path;
+
+    /** RoutePathHash() of the path, compared before the path itself */
+    uint64_t hash;
+
+    /** First of the path's routes, which are contiguous in the table */
+    uint32_t first;
+
+    /** Number of methods of the path */
+    uint32_t count;
+  };
+
+  /** Slot value marking no path */
+  static constexpr uint32_t kEmpty = UINT32_MAX;
+
+  /** Empty view, matching nothing */
+  constexpr RouteTableView() = default;
+
+  /**
+   * @brief View the arrays of a table
+   * @param routes Routes grouped by path
+   * @param methods Recognised method of each route
+   * @param paths Distinct paths
+   * @param seeds Seed of each bucket, a power of two of them
+   * @param slots Index into paths, or kEmpty, a power of two of them
+   */
+  constexpr RouteTableView(std::span<const StaticRoute> routes, std::span<const HttpMethod> methods,
+                           std::span<const Path> paths, std::span<const uint32_t> seeds,
+                           std::span<const uint32_t> slots)
+    : routes_(routes), methods_(methods), paths_(paths), seeds_(seeds), slots_(slots) {}
+
+  /** @return true if the view holds no route */
+  bool Empty() const { return routes_.empty(); }
+
+  /** @return Number of routes, the indices go from 0 to Size() - 1 */
+  size_t Size() const { return routes_.size(); }
+
+  /** @return Route at an index, the routes of a path are contiguous */
+  const StaticRoute& Route(size_t index) const { return routes_[index]; }
+
+  /**
+   * @brief Find the path of a request: one hash, two table loads and a comparison
+   *
+   * A path the table does not hold is almost always told apart by its hash,
+   * without comparing strings, so Router's own routes pay little for the table.
+   * @param path Request path without the query string
+   * @return The path and its routes, nullptr if the table does not hold it
+   */
+  const Path* FindPath(std::string_view path) const {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    uint64_t hash = detail::RoutePathHash(path);
+    uint32_t seed = seeds_[hash & (seeds_.size() - 1)];
+    uint32_t index = slots_[detail::RouteSlotHash(hash, seed) & (slots_.size() - 1)];
+    if (index == kEmpty || paths_[index].hash != hash || paths_[index].path != path) {
+      return nullptr;
+    }
+    return &paths_[index];
+  }
+
+  /**
+   * @brief Find the route of a method on a path
+   * @param path Path found by FindPath()
+   * @param id Recognised request method, compared first
+   * @param method Request method, compared when id is HttpMethod::OTHER
+   * @return Index of the route, kEmpty if the path has no such method
+   */
+  uint32_t FindMethod(const Path& path, HttpMethod id, std::string_view method) const {
+    for (uint32_t i = path.first; i < path.first + path.count; ++i) {
+      if (methods_[i] == id && (id != HttpMethod::OTHER || routes_[i].method == method)) {
+        return i;
+      }
+    }
+    return kEmpty;
+  }
+
+  /**
+   * @brief Append the methods of a path to an Allow header value
+   * @param path Path found by FindPath()
+   * @param allow Value to append to, comma separated
+   */
+  void AppendAllow(const Path& path, std::string& allow) const {
+    for (uint32_t i = path.first; i < path.first + path.count; ++i) {
+      allow += allow.empty() ? "" : ", ";
+      allow += routes_[i].method;
+    }
+  }
+
+private:
+  std::span<const StaticRoute> routes_;
+  std::span<const HttpMethod> methods_;
+  std::span<const Path> paths_;
+  std::span<const uint32_t> seeds_;
+  std::span<const uint32_t> slots_;
+};
+
+/**
+ * @class RouteTable
+ * @brief Routes fixed at compile time, found through a perfect hash built by the compiler
+ *
+ * The constructor runs at compile time: it groups the routes by path and
+ * builds a hash-and-displace perfect hash over the distinct paths (Belazzougui
+ * et al., "Hash, displace, and compress"). Paths hash into N / 2 buckets,
+ * and each bucket gets the seed that sends all its paths to free slots of a
+ * table of at least 2N. Finding a path then costs one hash of it, a seed
+ * load, a slot load and one string comparison, whatever N is; the method is
+ * compared among that path's few routes. Handlers are plain function
+ * pointers called directly. A duplicate route, a path that is not a static
+ * absolute path, or a seed search that fails make the program ill-formed.
+ *
+ * Paths are exact: parameters and wildcards stay with Router, which looks
+ * the table up before its own tree (see Router::SetRouteTable()).
+ * @code
+ * constexpr revak::StaticRoute kRoutes[] = {
+ *   {"GET", "/health", [](const revak::Request&) { return revak::Response(); }},
+ * };
+ * constexpr revak::RouteTable kTable(kRoutes);
+ * server.SetRouteTable(kTable);
+ * @endcode
+ * @tparam N Number of routes
+ */
+template <size_t N>
+class RouteTable {
+public:
+  static_assert(N > 0, "a route table needs at least one route");
+
+  /** Slots of the perfect hash, at most half of them used */
+  static constexpr size_t kSlots = std::bit_ceil(2 * N);
+
+  /** Buckets of the first-level hash, about two paths each */
+  static constexpr size_t kBuckets = std::bit_ceil(N / 2 + 1);
+
+  /**
+   * @brief Build the table; only valid in constant evaluation
+   * @param routes Routes, in any order
+   */
+  consteval explicit RouteTable(std::span<const StaticRoute, N> routes) {
+    struct Key {
+      uint64_t hash;
+      uint32_t index;
+    };
+    std::array<Key, N> keys{};
+    for (size_t i = 0; i < N; ++i) {
+      const StaticRoute& route = routes[i];
+      if (route.method.empty() || route.handler == nullptr) {
+        throw "route without method or handler";
+      }
+      if (route.path.empty() || route.path[0] != '/' || route.path.find_first_of(":*?") != std::string_view::npos) {
+        throw "route paths must be static and start with '/'";
+      }
+      keys[i] = {detail::RoutePathHash(route.path), static_cast<uint32_t>(i)};
+    }
+    // Sorting on the hash groups the paths without comparing strings, which is
+    // what keeps a table of a thousand routes within the constant evaluation limits
+    std::sort(keys.begin(), keys.end(), [&routes](const Key& a, const Key& b) {
+      return a.hash != b.hash ? a.hash < b.hash : routes[a.index].method < routes[b.index].method;
+    });
+
+    for (size_t i = 0; i < N; ++i) {
+      routes_[i] = routes[keys[i].index];
+      methods_[i] = ParseMethod(routes_[i].method);
+      if (i > 0 && keys[i].hash == keys[i - 1].hash) {
+        if (routes_[i].path != routes_[i - 1].path) {
+          throw "two route paths share a hash";
+        }
+        if (routes_[i].method == routes_[i - 1].method) {
+          throw "duplicate route";
+        }
+        paths_[path_count_ - 1].count++;
+        continue;
+      }
+      paths_[path_count_++] = {routes_[i].path, keys[i].hash, static_cast<uint32_t>(i), 1};
+    }
+    BuildHash();
+  }
+
+  /** @return Lookup over the table */
+  constexpr RouteTableView View() const {
+    return RouteTableView(routes_, methods_, std::span<const RouteTableView::Path>(paths_.data(), path_count_),
+                          seeds_, slots_);
+  }
+
+  /** Tables convert to their view, so they can be passed where one is expected */
+  constexpr operator RouteTableView() const { return View(); }
+
+private:
+  /** Find a seed for every bucket, the fullest buckets first while the slots are emptiest */
+  consteval void BuildHash() {
+    std::array<uint32_t, N> by_bucket{};
+    for (size_t p = 0; p < path_count_; ++p) {
+      by_bucket[p] = static_cast<uint32_t>(p);
+    }
+    auto bucket_of = [this](uint32_t p) { return paths_[p].hash & (kBuckets - 1); };
+    std::sort(by_bucket.begin(), by_bucket.begin() + path_count_,
+              [&bucket_of](uint32_t a, uint32_t b) { return bucket_of(a) < bucket_of(b); });
+
+    // Each bucket's paths are a run of by_bucket
+    struct Run {
+      size_t first;
+      size_t count;
+    };
+    std::array<Run, kBuckets> runs{};
+    for (size_t i = 0; i < path_count_;) {
+      size_t end = i;
+      while (end < path_count_ && bucket_of(by_bucket[end]) == bucket_of(by_bucket[i])) {
+        ++end;
+      }
+      runs[bucket_of(by_bucket[i])] = {i, end - i};
+      i = end;
+    }
+    std::array<uint32_t, kBuckets> order{};
+    for (size_t b = 0; b < kBuckets; ++b) {
+      order[b] = static_cast<uint32_t>(b);
+    }
+    std::sort(order.begin(), order.end(), [&runs](uint32_t a, uint32_t b) { return runs[a].count > runs[b].count; });
+    slots_.fill(RouteTableView::kEmpty);
+
+    std::array<size_t, N> taken{};
+    for (uint32_t bucket : order) {
+      const Run& run = runs[bucket];
+      if (run.count == 0) {
+        break;
+      }
+
+      bool placed = false;
+      for (uint32_t seed = 0; seed < kMaxSeed && !placed; ++seed) {
+        placed = true;
+        for (size_t m = 0; m < run.count && placed; ++m) {
+          taken[m] = detail::RouteSlotHash(paths_[by_bucket[run.first + m]].hash, seed) & (kSlots - 1);
+          placed = slots_[taken[m]] == RouteTableView::kEmpty
+                   && std::find(taken.begin(), taken.begin() + m, taken[m]) == taken.begin() + m;
+        }
+        if (placed) {
+          seeds_[bucket] = seed;
+          for (size_t m = 0; m < run.count; ++m) {
+            slots_[taken[m]] = by_bucket[run.first + m];
+          }
+        }
+      }
+      if (!placed) {
+        throw "no perfect hash found for the route paths";
+      }
+    }
+  }
+
+  /** Seeds tried per bucket before giving up */
+  static constexpr uint32_t kMaxSeed = 1u << 16;
+
+  /** Routes grouped by path, sorted by method within a path */
+  std::array<StaticRoute, N> routes_{};
+
+  /** Recognised method of each route */
+  std::array<HttpMethod, N> methods_{};
+
+  /** Distinct paths, the first path_count_ used */
+  std::array<RouteTableView::Path, N> paths_{};
+  size_t path_count_{0};
+
+  /** Seed of each bucket */
+  std::array<uint32_t, kBuckets> seeds_{};
+
+  /** Index into paths_ of the path hashing to each slot, kEmpty if none */
+  std::array<uint32_t, kSlots> slots_{};
+};
+
+/** Deduce the size of a table from an array of routes */
+template <size_t N>
+RouteTable(const StaticRoute (&)[N]) -> RouteTable<N>;
+
+/** Deduce the size of a table from a std::array of routes */
+template <size_t N>
+RouteTable(const std::array<StaticRoute, N>&) -> RouteTable<N>;
+
+} // namespace revak
@@ -11,9 +11,15 @@
 #include "Handler.h"
 #include "Response.h"
 #include "Request.h"
+#include "RouteTable.h"
 
-#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace revak {
 
@@ -26,36 +32,191 @@ struct Route
   std::string method;
   std::string path;
   Handler handler;
+
+  /** Coroutine handler, set instead of handler */
+  AsyncHandler async_handler;
 };
 
 /**
  * @class Router
  * @brief Manages routing of HTTP requests to their corresponding handlers
+ *
+ * Routes are stored in a compressed radix tree keyed by path. A path may
+ * contain ":name" segments, which capture one path segment, and a final
+ * "*name" segment, which captures the rest of the path; captured values are
+ * available through Request::Param(). Static segments take precedence over
+ * parameters, which take precedence over wildcards. Matching walks the tree
+ * once per path byte and does not allocate.
+ *
+ * Routes can be added and removed while requests are dispatched. The tree
+ * is immutable once published: an update copies the nodes on the path it
+ * changes, shares the rest with the current tree and swaps the root
+ * pointer, and the old tree is freed through Epoch once no dispatch can
+ * still see it. Dispatching takes no lock and touches no reference count;
+ * updates are serialised by a mutex and cost O(path length) node copies.
+ *
+ * Exact paths known at compile time can be given as a RouteTable instead,
+ * which is looked up before the tree (see SetRouteTable()).
+ * @code
+ * router.AddRoute("GET", "/users/:id", handler); // /users/42 -> Param("id") == "42"
+ * @endcode
  */
 class Router {
 public:
+  Router();
+  ~Router();
+
+  // Disable copy
+  Router(const Router&) = delete;
+  Router& operator=(const Router&) = delete;
+
   /**
    * @brief Add a route to the router
    * @param method HTTP method (e.g., "GET", "POST")
-   * @param path URL path (e.g., "/home")
+   * @param path URL path, may contain ":param" and a trailing "*wildcard" segment
    * @param handler Handler function to process the request
    * @return true if the route was added successfully, false otherwise
    */
   bool AddRoute(const std::string& method, const std::string& path, Handler handler);
 
+  /**
+   * @brief Add a route served by a coroutine handler
+   * @param method HTTP method (e.g., "GET", "POST")
+   * @param path URL path, may contain ":param" and a trailing "*wildcard" segment
+   * @param handler Coroutine handler to process the request
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool AddRoute(const std::string& method, const std::string& path, AsyncHandler handler);
+
+  /**
+   * @brief Remove a route; requests already dispatched to it finish normally
+   *
+   * The route keeps its id, with its method and path but without handlers,
+   * so the metrics recorded under it stay labelled.
+   * @param method HTTP method of the route
+   * @param path URL path pattern, as given to AddRoute()
+   * @return true if the route was removed, false if there is no such route
+   */
+  bool RemoveRoute(const std::string& method, const std::string& path);
+
+  /**
+   * @brief Serve the routes of a compile-time table ahead of the tree
+   *
+   * A request whose path and method are in the table goes straight to its
+   * function, without walking the tree; any other request is matched by the
+   * tree as before, so the table's routes take precedence over the tree's.
+   * The routes get ids after the routes already added, in table order. A
+   * later call replaces the table, the routes of the previous one keeping
+   * their ids without handlers, like removed routes.
+   * @param routes View of a RouteTable, which must outlive the router
+   * @return true if the table was set, false if it is empty
+   */
+  bool SetRouteTable(RouteTableView routes);
+
   /**
    * @brief Dispatch a request to the appropriate handler based on method and path
-   * @param request The incoming HTTP request
+   *
+   * Answers 404 when no route matches the path, and 405 with an Allow header
+   * when the path matches but not for the request method.
+   * @param request The incoming HTTP request, receives the captured path parameters
+   *        and the id of the matched route (Request::kNoRoute if none)
+   * A coroutine handler runs on the calling thread, its awaits blocking it.
    * @return The response generated by the handler
    */
-  Response Dispatch(const Request& request);
+  Response Dispatch(Request& request);
+
+  /**
+   * @brief Dispatch a request, leaving a coroutine handler's task to the caller
+   * @param request The incoming HTTP request, as for Dispatch()
+   * @param task Receives the unstarted task when the route has a coroutine handler
+   * @return The response of a plain handler (or 404 / 405), std::nullopt when task was set
+   */
+  std::optional<Response> TryDispatch(Request& request, Task<Response>& task);
+
+  /** @return Number of routes added, removed ones included; the ids go from 0 to RouteCount() - 1 */
+  size_t RouteCount() const;
+
+  /**
+   * @brief Get a route by id, in the order the routes were added
+   * @param id Route id, see Request::RouteId()
+   * @return Method, path pattern and handler of the route (no handler once removed), null if there is no such id
+   */
+  std::shared_ptr<const Route> GetRoute(size_t id) const;
 
 private: 
-  /** 
-   * @brief Map to store routes with method and path as keys
-   * The outer map's key is the HTTP method, and the inner map's key is the URL path.
+  struct Node;
+  struct Endpoint;
+  struct Table;
+
+  /**
+   * @brief Find the handler of a request, capturing its path parameters and route id
+   * @param table Routes to search
+   * @param request The incoming HTTP request
+   * @param node Receives the node matching the path, nullptr if none
+   * @return Endpoint of the request method, nullptr if the path or the method does not match
+   */
+  static const Endpoint* Find(const Table& table, Request& request, const Node*& node);
+
+  /**
+   * @brief Find the route of a request in the compile-time table, setting its route id
+   * @param table Routes to search
+   * @param request The incoming HTTP request
+   * @param path Receives the table's entry for the request path, nullptr if none
+   * @return Route of the request method, nullptr if the path or the method is not in the table
+   */
+  static const StaticRoute* FindStatic(const Table& table, Request& request, const RouteTableView::Path*& path);
+
+  /**
+   * @brief Answer a request without a handler
+   * @param table Routes searched
+   * @param node Node matching the path, nullptr if none
+   * @param path Table entry matching the path, nullptr if none
+   * @return 405 with an Allow header if the path matched, 404 otherwise
+   */
+  static Response Reject(const Table& table, const Node* node, const RouteTableView::Path* path);
+
+  /**
+   * @brief Add a route with one of the two kinds of handler
+   * @param route Method, path and handler of the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool AddEndpoint(Route route);
+
+  /**
+   * @brief Replace the current routes, retiring the previous table
+   * @param table New routes
    */
-  std::map<std::string, std::map<std::string, Handler>> routes_;
+  void Publish(std::unique_ptr<Table> table);
+
+  /**
+   * @brief Replace a node shared with the published tree by a private copy
+   * @param node Link to the node, repointed at the copy
+   * @return The copy, free to modify
+   */
+  static Node* Own(std::shared_ptr<Node>& node);
+
+  /**
+   * @brief Insert static path text below a node, splitting prefixes as needed
+   * @param node Node the text continues from, already owned
+   * @param text Static text (no parameters)
+   * @return Node whose path ends with the text
+   */
+  static Node* InsertStatic(Node* node, std::string_view text);
+
+  /**
+   * @brief Find the node matching the rest of a path
+   * @param node Node whose own prefix is already matched
+   * @param rest Unmatched part of the path
+   * @param request Request receiving the captured parameters
+   * @return Matching node with handlers, nullptr if there is none
+   */
+  static const Node* Match(const Node* node, std::string_view rest, Request& request);
+
+  /** Current routes, read under an Epoch::Guard */
+  std::atomic<const Table*> table_;
+
+  /** Serialises the updates */
+  std::mutex update_mutex_;
 };
 
-}  // namespace revak
\ No newline at end of file
+}  // namespace revak
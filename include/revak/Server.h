@@ -8,13 +8,51 @@
 
 #pragma once
 
+#include "AdmissionController.h"
+#include "Async.h"
+#include "Connection.h"
+#include "EventLoop.h"
+#include "IoUring.h"
+#include "Metrics.h"
+#include "ResponseCache.h"
 #include "Router.h"
 #include "Socket.h"
+#include "StaticFiles.h"
 #include "ThreadPool.h"
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace revak {
+
+/**
+ * @enum IoMode
+ * @brief Selects how the server waits for and reads client connections
+ */
+enum class IoMode {
+  /** Accept on the calling thread, each connection blocks one pool thread while it is read */
+  BLOCKING,
+  /** Edge-triggered epoll reactor, only fully received requests reach the pool */
+  EPOLL,
+  /**
+   * One SO_REUSEPORT listener and reactor per thread, each pinned to a CPU;
+   * requests are handled inline, so a connection never leaves its core
+   */
+  SHARDED,
+  /**
+   * Like EPOLL, but accepts, receives and sends through io_uring completions
+   * (multishot accept and recv into provided buffers, batched submissions);
+   * falls back to EPOLL when the kernel does not support it
+   */
+  IO_URING
+};
+
 /**
  * @class Server
  * @brief Represents an HTTP server with routing and multithreading capabilities
@@ -24,9 +62,10 @@ public:
   /**
    * @brief Create a new Server instance
    * @param port Port number to bind the server
-   * @param thread_nums Number of threads in the thread pool (default is 4)
+   * @param thread_nums Number of threads in the thread pool, or of shards in IoMode::SHARDED (default is 4)
+   * @param io_mode Connection I/O strategy (default is IoMode::BLOCKING)
    */
-  explicit Server(uint16_t port, size_t thread_nums = 4);
+  explicit Server(uint16_t port, size_t thread_nums = 4, IoMode io_mode = IoMode::BLOCKING);
 
   /** Destructor to stop the server */
   ~Server();
@@ -43,6 +82,9 @@ public:
 
   /**
    * @brief Add a route to the server's router
+   *
+   * Routes can be added and removed while the server is running; requests
+   * being dispatched never wait for the update.
    * @param method HTTP method (e.g., "GET", "POST")
    * @param path URL path (e.g., "/home")
    * @param handler Handler function to process the request
@@ -50,6 +92,39 @@ public:
    */
   bool AddRoute(const std::string& method, const std::string& path, Handler handler);
 
+  /**
+   * @brief Add a route served by a coroutine handler
+   *
+   * While the handler is suspended on an awaitable (Sleep(), Readable(),
+   * Receive()...) no thread is held: the wait is registered on the
+   * connection's event loop and the handler resumes on a worker (on the
+   * shard's own thread in IoMode::SHARDED). Requests pipelined behind it
+   * are answered once it finishes, in order.
+   * @param method HTTP method (e.g., "GET", "POST")
+   * @param path URL path (e.g., "/home")
+   * @param handler Coroutine handler to process the request
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool AddRoute(const std::string& method, const std::string& path, AsyncHandler handler);
+
+  /**
+   * @brief Remove a route from the server's router, also while the server is running
+   * @param method HTTP method of the route
+   * @param path URL path pattern the route was added with
+   * @return true if the route was removed, false if there is no such route
+   */
+  bool RemoveRoute(const std::string& method, const std::string& path);
+
+  /**
+   * @brief Serve routes fixed at compile time through a perfect hash
+   *
+   * Requests for the table's exact paths skip the radix tree and call the
+   * route's function directly; the other routes keep working as before.
+   * @param routes A constexpr RouteTable, or a view of one, outliving the server
+   * @return true if the table was set, false if it is empty
+   */
+  bool SetRouteTable(RouteTableView routes);
+
   /**
    * @brief Shortcut for adding GET route
    * @param path Request path
@@ -58,6 +133,29 @@ public:
    */
   bool Get(const std::string& path, Handler handler);
 
+  /**
+   * @brief Shortcut for adding GET route with a coroutine handler
+   * @param path Request path
+   * @param handler Coroutine handler for the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool Get(const std::string& path, AsyncHandler handler);
+
+  /**
+   * @brief Add a GET route whose responses are cached
+   *
+   * The handler runs on a miss; hits within the TTL are answered from the
+   * server's ResponseCache, with an ETag and 304 for a matching If-None-Match.
+   * @code
+   * server.Get("/api/catalog", handler, {.ttl = std::chrono::minutes(5), .vary = {"Accept-Language"}});
+   * @endcode
+   * @param path Request path
+   * @param handler Handler function for the route
+   * @param options TTL and vary headers of the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool Get(const std::string& path, Handler handler, CacheOptions options);
+
   /**
    * @brief Shortcut for adding POST route
    * @param path Request path
@@ -66,6 +164,14 @@ public:
    */
   bool Post(const std::string& path, Handler handler);
 
+  /**
+   * @brief Shortcut for adding POST route with a coroutine handler
+   * @param path Request path
+   * @param handler Coroutine handler for the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool Post(const std::string& path, AsyncHandler handler);
+
   /**
    * @brief Shortcut for adding PUT route
    * @param path Request path
@@ -73,6 +179,14 @@ public:
    * @return true if the route was added successfully, false otherwise
    */
   bool Put(const std::string& path, Handler handler);
+
+  /**
+   * @brief Shortcut for adding PUT route with a coroutine handler
+   * @param path Request path
+   * @param handler Coroutine handler for the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool Put(const std::string& path, AsyncHandler handler);
   
   /**
    * @brief Shortcut for adding DELETE route
@@ -82,24 +196,442 @@ public:
    */
   bool Delete(const std::string& path, Handler handler);
 
+  /**
+   * @brief Shortcut for adding DELETE route with a coroutine handler
+   * @param path Request path
+   * @param handler Coroutine handler for the route
+   * @return true if the route was added successfully, false otherwise
+   */
+  bool Delete(const std::string& path, AsyncHandler handler);
+
+  /**
+   * @brief Serve the files of a directory under a URL prefix (GET and HEAD)
+   * @code
+   * server.Static("/assets", "./public"); // GET /assets/app.js -> ./public/app.js
+   * @endcode
+   * @param prefix URL prefix (e.g., "/assets", or "/" for the whole site)
+   * @param root Directory whose files are served
+   * @param options Cache and index settings
+   * @return true if the routes were added successfully, false otherwise
+   */
+  bool Static(const std::string& prefix, const std::string& root, StaticFileOptions options = {});
+
+  /**
+   * @brief Collect request, connection and thread pool metrics and serve them (GET)
+   *
+   * Per-route request counts and latency histograms, open connections and
+   * the pool's queue length and wait times, in the Prometheus text format.
+   * Nothing is measured unless this is called, before Run().
+   * @param path URL path of the metrics route
+   * @return true if the route was added successfully, false otherwise (also while running)
+   */
+  bool EnableMetrics(const std::string& path = "/metrics");
+
+  /**
+   * @brief Set how long an idle persistent connection is kept open
+   * @param timeout Idle timeout (default is 5 seconds), 0 to disable
+   */
+  void SetKeepAliveTimeout(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Set how long a request line and its headers may take to arrive, from their first byte (408 beyond)
+   * @param timeout Header timeout (default is 10 seconds), 0 to disable
+   */
+  void SetHeaderTimeout(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Set how long a request body may take to arrive, from the end of its headers (408 beyond)
+   * @param timeout Body timeout (default is 30 seconds), 0 to disable
+   */
+  void SetBodyTimeout(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Set how long a client may leave queued responses unread before it is disconnected
+   *
+   * Measured from the last byte the client accepted, so slow but steady
+   * downloads are not cut.
+   * @param timeout Write timeout (default is 30 seconds), 0 to disable
+   */
+  void SetWriteTimeout(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Set how many requests a persistent connection may serve before it is closed
+   * @param max_requests Maximum number of requests per connection (default is 1000)
+   */
+  void SetMaxKeepAliveRequests(size_t max_requests);
+
+  /**
+   * @brief Set the largest accepted request line plus header block (431 beyond)
+   * @param max_size Size in bytes (default is 16 KiB)
+   */
+  void SetMaxHeaderSize(size_t max_size);
+
+  /**
+   * @brief Set the largest accepted request body (413 beyond)
+   * @param max_size Size in bytes (default is 1 MiB)
+   */
+  void SetMaxBodySize(size_t max_size);
+
+  /**
+   * @brief Set how many connections' requests may wait for a worker (503 beyond)
+   *
+   * Requests read while this many batches are queued are answered at once
+   * with a pre-serialized 503 and Retry-After instead of being queued.
+   * Not used by IoMode::SHARDED, which handles requests inline.
+   * @param max_queued Number of queued batches, one per connection (default is 4096)
+   */
+  void SetMaxQueuedRequests(size_t max_queued);
+
+  /**
+   * @brief Set the queue delay the admission controller tolerates (CoDel)
+   *
+   * When the shortest time batches waited for a worker stayed above target
+   * for a whole interval, batches that waited more than twice the target
+   * are answered 503 instead of being handled. Not used by IoMode::SHARDED.
+   * @param target Tolerated standing queue delay (default is 5 ms), 0 to disable
+   * @param interval Time the delay must stay above target (default is 100 ms)
+   */
+  void SetQueueDelayTarget(std::chrono::milliseconds target,
+                           std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+  /**
+   * @brief Set the total size of the responses cached for cached GET routes
+   * @param max_bytes Size in bytes (default is 64 MiB)
+   */
+  void SetResponseCacheSize(size_t max_bytes);
+
 private:
+  /** Most sends linked into one chain for a connection */
+  static constexpr size_t kRingLinkedSends = 4;
+
+  /** Most buffers carried by one of those sends */
+  static constexpr size_t kRingSendIovecs = 64;
+
+  /**
+   * @struct RingConnection
+   * @brief A connection of IoMode::IO_URING with the state of its submitted operations
+   *
+   * Its address tags the operations' user_data, so it is only destroyed once
+   * the last of them completed.
+   */
+  struct RingConnection {
+    RingConnection(Socket socket, RequestParser::Limits limits) : connection(std::move(socket), limits) {}
+
+    /** Buffers and parser, shared with the epoll path */
+    Connection connection;
+
+    /** Bytes received while the connection's buffers were in use */
+    std::string deferred_input;
+
+    /** Messages and buffers of the sends in flight, valid until they complete */
+    std::array<msghdr, kRingLinkedSends> messages{};
+    std::array<iovec, kRingLinkedSends * kRingSendIovecs> iov{};
+
+    /** Operations submitted whose last completion has not arrived */
+    int operations{0};
+
+    /** Sends in flight */
+    int sends{0};
+
+    /** True while the multishot recv is armed */
+    bool receiving{false};
+
+    /** True while a cancellation of the recv is pending */
+    bool cancelling{false};
+
+    /** True while waiting for the socket to accept a file or stream body */
+    bool polling{false};
+
+    /** True once the peer closed its side or the socket failed */
+    bool peer_closed{false};
+
+    /** True once shut down; destroyed when no operation is left */
+    bool closed{false};
+  };
+
+  /**
+   * @struct Shard
+   * @brief A listener with the reactor that accepts and serves its connections
+   *
+   * IoMode::BLOCKING, IoMode::EPOLL and IoMode::IO_URING use a single shard,
+   * IoMode::SHARDED one per thread.
+   */
+  struct Shard {
+    /** Listening socket (SO_REUSEPORT in IoMode::SHARDED) */
+    Socket listener;
+
+    /** Reactor of the shard, unused in IoMode::BLOCKING */
+    EventLoop loop;
+
+    /** Open connections of the reactor, keyed by file descriptor */
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+
+    /** Waits and resumptions of the coroutine handlers of the shard's connections */
+    std::unique_ptr<Executor> executor;
+
+    /** Ring of IoMode::IO_URING while it runs; the loop above then only serves posted tasks and timers */
+    std::unique_ptr<IoUring> ring;
+
+    /** Open connections of IoMode::IO_URING, keyed by file descriptor */
+    std::unordered_map<int, std::unique_ptr<RingConnection>> ring_connections;
+  };
+
+  /** Accept loop of IoMode::BLOCKING */
+  void RunBlocking();
+
+  /**
+   * @brief Serve a connection of IoMode::BLOCKING until it ends (pool thread)
+   *
+   * Returns early while a coroutine handler is suspended; the handler's
+   * completion enqueues the connection again.
+   * @param connection Connection to serve
+   */
+  void ServeBlocking(const std::shared_ptr<Connection>& connection);
+
+  /** Start one pinned thread per shard and wait for them (IoMode::SHARDED) */
+  void RunSharded();
+
+  /**
+   * @brief Reactor loop of a shard, returns when the server stops
+   * @param shard Shard to run on the calling thread
+   */
+  void RunEventLoop(Shard& shard);
+
+  /**
+   * @brief io_uring reactor of a shard, returns when the server stops
+   *
+   * Falls back to RunEventLoop() if the ring cannot be set up.
+   * @param shard Shard to run on the calling thread
+   */
+  void RunIoUring(Shard& shard);
+
+  /**
+   * @brief Handle one io_uring completion (loop thread only)
+   * @param shard Shard owning the ring
+   * @param cqe Completion
+   */
+  void OnRingCompletion(Shard& shard, const io_uring_cqe& cqe);
+
+  /**
+   * @brief Send, read and handle or dispatch for an io_uring connection (loop thread only)
+   * @param shard Shard owning the connection
+   * @param ring_connection Connection to serve
+   */
+  void ServeRingConnection(Shard& shard, RingConnection* ring_connection);
+
+  /**
+   * @brief Submit the in-memory pending output as a chain of linked sends
+   * @param shard Shard owning the connection
+   * @param ring_connection Connection to send for
+   * @return false if the next bytes must be sent by Connection::Flush()
+   */
+  bool SubmitRingSends(Shard& shard, RingConnection* ring_connection);
+
+  /**
+   * @brief Shut a connection down; it is destroyed once its operations completed
+   * @param shard Shard owning the connection
+   * @param ring_connection Connection to close
+   */
+  void CloseRingConnection(Shard& shard, RingConnection* ring_connection);
+
+  /**
+   * @brief Continue serving a connection a worker handed back (loop thread only)
+   * @param shard Shard owning the connection
+   * @param connection Connection to serve
+   */
+  void ResumeConnection(Shard& shard, Connection* connection);
+
+  /**
+   * @brief Accept every pending connection and register it with the shard's event loop
+   * @param shard Shard whose listener is readable
+   */
+  void AcceptConnections(Shard& shard);
+
+  /**
+   * @brief Flush, read and handle or dispatch for a connection (loop thread only)
+   * @param shard Shard owning the connection
+   * @param connection Connection to serve
+   */
+  void ServeConnection(Shard& shard, Connection* connection);
+
+  /**
+   * @brief Parse the complete requests buffered on a connection into its batch
+   *
+   * At most 64 are taken; the rest stay buffered and are
+   * parsed once the batch is answered.
+   * @param connection Connection to parse from
+   * @return HTTP status of a parse error, 0 if none
+   */
+  int CollectRequests(Connection& connection);
+
+  /**
+   * @brief Hand the connection's batch of pipelined requests to the thread pool
+   * @param shard Shard owning the connection
+   * @param connection Connection the requests were read from
+   * @param error_status Parse error that follows the requests, 0 if none
+   */
+  void DispatchBatch(Shard& shard, Connection* connection, int error_status);
+
+  /**
+   * @brief Hand a connection back to its loop thread once a worker is done with it
+   * @param shard Shard owning the connection
+   * @param connection Busy connection, no longer busy on the loop thread
+   */
+  void HandBack(Shard& shard, Connection* connection);
+
+  /**
+   * @brief Pull the next piece of a streamed body on the thread pool
+   * @param shard Shard owning the connection
+   * @param connection Connection whose stream needs data
+   */
+  void DispatchStreamPull(Shard& shard, Connection* connection);
+
+  /**
+   * @brief Handle pipelined requests in order and queue their responses as one write
+   *
+   * Applies the Connection header semantics and the per-connection request
+   * limit; marks the connection closing when it must not serve more requests.
+   * Clears the connection's batch when done.
+   *
+   * When a coroutine handler suspends, returns false at once; the thread
+   * finishing the handler then handles the rest of the batch and calls done.
+   * The connection must stay busy until then.
+   * @param shard Shard owning the connection, whose executor runs the coroutine handlers
+   * @param connection Connection the requests were read from
+   * @param error_status Parse error answered after the requests, 0 if none
+   * @param done Called once the batch is finished, only if false was returned
+   * @param first Index of the first request left to handle
+   * @return true if the batch is finished
+   */
+  bool HandleBatch(Shard& shard, Connection& connection, int error_status, const std::function<void()>& done,
+                   size_t first = 0);
+
+  /**
+   * @brief Answer every request of a batch with the overload 503 instead of handling it
+   * @param connection Connection the requests were read from
+   * @param error_status Parse error answered after the requests, 0 if none
+   */
+  void ShedBatch(Connection& connection, int error_status);
+
+  /**
+   * @brief Answer a trailing parse error and clear the batch
+   * @param connection Connection the requests were read from
+   * @param error_status Parse error answered after the requests, 0 if none
+   */
+  void FinishBatch(Connection& connection, int error_status);
+
+  /**
+   * @brief Refuse a connection of IoMode::BLOCKING with the overload 503 and close it
+   *
+   * The 503 gets a single non-blocking send: whatever it manages, the
+   * connection is closed when the caller drops it.
+   * @param connection Connection to refuse
+   */
+  void RefuseConnection(Connection& connection);
+
+  /**
+   * @brief Count a handled request in the metrics
+   * @param req Request answered
+   * @param res Response of its handler
+   * @param started Time the handler was called
+   */
+  void RecordRequest(const Request& req, const Response& res, std::chrono::steady_clock::time_point started);
+
+  /**
+   * @brief Frame and queue the response to one request
+   * @param connection Connection the request was read from
+   * @param req Request answered
+   * @param res Response to send
+   * @return false if the connection must not serve more requests (it is marked closing)
+   */
+  bool QueueResponse(Connection& connection, const Request& req, Response res);
+
+  /**
+   * @brief Get the timeout configured for a wait
+   * @param wait What a connection waits for
+   * @return Timeout, 0 if the wait is unbounded
+   */
+  std::chrono::milliseconds TimeoutOf(Connection::Wait wait) const;
+
+  /**
+   * @brief Arm a reactor connection's timer for what it waits for now (loop thread only)
+   *
+   * Header and body deadlines run from the start of the wait, the idle and
+   * write ones from the last progress, so they move on every call.
+   * @param shard Shard owning the connection
+   * @param connection Connection to arm the timer of
+   */
+  void UpdateTimeout(Shard& shard, Connection& connection);
+
+  /**
+   * @brief Answer 408 to a late request, or close a connection whose idle or write timeout expired
+   * @param shard Shard owning the connection
+   * @param connection Connection whose timer expired
+   */
+  void ExpireConnection(Shard& shard, Connection* connection);
+
+  /**
+   * @brief Unregister and destroy a connection (loop thread only)
+   * @param shard Shard owning the connection
+   * @param connection Connection to close
+   */
+  void CloseConnection(Shard& shard, Connection* connection);
+
   /** Port number to bind the server */
   uint16_t port_;
 
-  /** Number of threads in the thread pool */
+  /** Number of threads in the thread pool, or of shards */
   size_t thread_nums_;
+
+  /** Connection I/O strategy */
+  IoMode io_mode_;
+
+  /** Idle timeout of persistent connections */
+  std::chrono::milliseconds keep_alive_timeout_{5000};
+
+  /** Time allowed for a request line and headers, from their first byte */
+  std::chrono::milliseconds header_timeout_{10000};
+
+  /** Time allowed for a request body, from the end of the headers */
+  std::chrono::milliseconds body_timeout_{30000};
+
+  /** Time a client may leave queued responses unread */
+  std::chrono::milliseconds write_timeout_{30000};
+
+  /** Maximum number of requests served on one connection */
+  size_t max_keep_alive_requests_{1000};
+
+  /** Request size limits applied by each connection's parser */
+  RequestParser::Limits parser_limits_;
   
   /** Atomic flag to control server running state */
   std::atomic<bool> running_{false};
   
-  /** Socket for handling network connections */
-  Socket socket_;
+  /** Listeners with their reactors, exactly one unless in IoMode::SHARDED */
+  std::vector<std::unique_ptr<Shard>> shards_;
 
-  /** Thread pool for handling requests concurrently */
-  ThreadPool thread_pool_;
+  /** Threads running the shards of IoMode::SHARDED */
+  std::vector<std::thread> shard_threads_;
 
   /** Router for managing routes and dispatching requests */
   Router router_;
+
+  /** Sheds the batches that waited too long for a worker, which call Admit() until thread_pool_ is joined */
+  AdmissionController admission_;
+
+  /** Responses of the routes added with CacheOptions, shared with their handlers */
+  std::shared_ptr<ResponseCache> response_cache_{std::make_shared<ResponseCache>()};
+
+  /** Request and connection metrics, null unless EnableMetrics() was called */
+  std::unique_ptr<Metrics> metrics_;
+
+  /**
+   * Thread pool for handling requests concurrently (idle in IoMode::SHARDED)
+   *
+   * Declared last so that it is destroyed, joining the workers, before the
+   * members their tasks use.
+   */
+  ThreadPool thread_pool_;
 };
 
 } // namespace revak 
\ No newline at end of file
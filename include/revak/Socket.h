@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
+#include <string>
 #include <sys/socket.h>
 
 namespace revak {
@@ -25,6 +27,13 @@ public:
   /** Destructor to close the socket if open (close() syscall) */
   ~Socket();
 
+  /**
+   * @brief Take ownership of a connected socket created elsewhere (e.g. accepted by io_uring)
+   * @param fd File descriptor
+   * @return Socket owning the descriptor
+   */
+  [[nodiscard]] static Socket FromNativeHandle(int fd) { return Socket(fd); }
+
   // Delete Copy
   Socket(const Socket&) = delete;
   Socket& operator=(const Socket&) = delete;
@@ -33,18 +42,38 @@ public:
   Socket(Socket&& other) noexcept;
   Socket& operator=(Socket&& other) noexcept;
 
+  /** Let several sockets bind the same port, the kernel balances connections across them (SO_REUSEPORT) */
+  bool SetReusePort();
+
   /** Bind the socket to a specific port */
   bool Bind(uint16_t port);
 
   /** Put the socket into listening mode */
   bool Listen();
 
+  /**
+   * @brief Connect to a server (blocking)
+   * @param host Host name or IPv4 address
+   * @param port Port number
+   * @return true if the connection was established
+   */
+  bool Connect(const std::string& host, uint16_t port);
+
+  /** Send small writes immediately instead of coalescing them (TCP_NODELAY) */
+  bool SetNoDelay();
+
   /** Accepts incoming connection and returns new Socket object */
   [[nodiscard]] Socket Accept();
 
   /** Puts the Socket in non-blocking mode */
   bool SetNonBlocking();
 
+  /** Makes blocking reads give up after the given timeout (SO_RCVTIMEO) */
+  bool SetReceiveTimeout(std::chrono::milliseconds timeout);
+
+  /** Makes blocking writes give up when no byte was sent for the given timeout (SO_SNDTIMEO) */
+  bool SetSendTimeout(std::chrono::milliseconds timeout);
+
   /** Close the socket */
   bool Close();
 
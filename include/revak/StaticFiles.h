@@ -0,0 +1,136 @@
+/**
+ * @file StaticFiles.h
+ * @brief StaticFiles class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "Request.h"
+#include "Response.h"
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace revak {
+
+/**
+ * @struct StaticFileOptions
+ * @brief Tuning of a static directory handler
+ */
+struct StaticFileOptions {
+  /** Files up to this size are kept in memory, larger ones are sent with sendfile(2) */
+  size_t max_cached_file_size = 256 * 1024;
+
+  /** Total size of the file contents kept in memory, the least recently used evicted beyond it */
+  size_t max_cache_bytes = 64 * 1024 * 1024;
+
+  /** How long a cached file is trusted before it is checked against the disk again */
+  std::chrono::milliseconds revalidate_interval{1000};
+
+  /** File served for a directory */
+  std::string index_file = "index.html";
+};
+
+/**
+ * @class StaticFiles
+ * @brief Serves the files below a root directory
+ *
+ * Registered through the Router under a "*path" wildcard route. Small files
+ * are cached in memory together with their ETag and Last-Modified headers
+ * and sent without copying; larger files are streamed with sendfile(2).
+ * A directory is answered with its index file, or with a 301 to the path
+ * with a trailing slash so that relative links resolve inside it. Supports If-None-Match / If-Modified-Since (304), single byte ranges
+ * (206 / 416) with If-Range, and HEAD.
+ */
+class StaticFiles {
+public:
+  /** Name of the wildcard route parameter holding the file path */
+  static constexpr std::string_view kPathParam = "path";
+
+  /**
+   * @brief Create a handler for a directory
+   * @param root Directory whose files are served
+   * @param options Cache and index settings
+   */
+  explicit StaticFiles(std::string root, StaticFileOptions options = {});
+
+  // Disable copy and assignment
+  StaticFiles(const StaticFiles&) = delete;
+  StaticFiles& operator=(const StaticFiles&) = delete;
+
+  /**
+   * @brief Answer a GET or HEAD request for the file named by the path parameter
+   * @param request Request matched by a route ending in "*path"
+   * @return File response, or 301, 304, 400, 403, 404, 416 or 500
+   */
+  Response Serve(const Request& request);
+
+private:
+  /** A file's metadata and, for small files, its contents */
+  struct FileEntry;
+
+  /**
+   * @brief Get a file from the cache or the disk
+   * @param path Filesystem path
+   * @param status Receives the error status when nullptr is returned (404 also for directories)
+   * @param is_directory Receives true if the path is a directory
+   * @return File entry, nullptr on error
+   */
+  std::shared_ptr<const FileEntry> Lookup(const std::string& path, int& status, bool& is_directory);
+
+  /**
+   * @brief Open and stat a file, reading and caching it when small enough
+   * @param path Filesystem path
+   * @param status Receives the error status when nullptr is returned
+   * @param is_directory Receives true if the path is a directory
+   * @return File entry, nullptr on error
+   */
+  std::shared_ptr<const FileEntry> Load(const std::string& path, int& status, bool& is_directory);
+
+  /**
+   * @brief Build the response for a file, applying conditionals and ranges
+   * @param request Request being answered
+   * @param entry File to answer with
+   * @return 200, 206, 304 or 416 response
+   */
+  Response Respond(const Request& request, const FileEntry& entry) const;
+
+  /** Directory whose files are served, without a trailing slash */
+  std::string root_;
+
+  /** Cache and index settings */
+  StaticFileOptions options_;
+
+  /** Cached files by filesystem path, most recently used first */
+  using CacheList = std::list<std::pair<std::string, std::shared_ptr<const FileEntry>>>;
+
+  /**
+   * @brief Drop a cached file
+   * @param position Position of the file in cache_lru_
+   */
+  void Evict(CacheList::iterator position);
+
+  /** Mutex for the cache */
+  std::mutex cache_mutex_;
+
+  /** Cached small files, most recently used first */
+  CacheList cache_lru_;
+
+  /** Cached files by filesystem path; the keys view the paths in cache_lru_ */
+  std::unordered_map<std::string_view, CacheList::iterator> cache_;
+
+  /** Total size of the cached contents */
+  size_t cached_bytes_{0};
+};
+
+} // namespace revak
@@ -0,0 +1,243 @@
+/**
+ * @file Task.h
+ * @brief Task coroutine type declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include "Arena.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+
+namespace revak {
+
+class Executor;
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+/**
+ * @struct TaskPromiseBase
+ * @brief Promise state shared by every Task: where it runs and who waits for it
+ */
+struct TaskPromiseBase {
+  /** Executor of the request the coroutine serves, null outside the server */
+  Executor* executor{nullptr};
+
+  /** Memory resource current when the coroutine was created, restored on resumption */
+  std::pmr::memory_resource* memory{CurrentMemoryResource()};
+
+  /** Coroutine awaiting this one, resumed when it finishes */
+  std::coroutine_handle<> continuation;
+
+  /** Completion set by Task::Then() on a top-level task */
+  std::function<void()> on_done;
+
+  /** Set by the first of the coroutine finishing and Then(); the second runs the completion */
+  std::atomic<bool> finished{false};
+
+  /** Exception that escaped the coroutine */
+  std::exception_ptr error;
+
+  /** Final suspension: resume the awaiting coroutine, or run the completion */
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      TaskPromiseBase& promise = handle.promise();
+      if (promise.continuation) {
+        return promise.continuation;
+      }
+      // Then() was called first: the completion owns the frame and may destroy it
+      if (promise.finished.exchange(true, std::memory_order_acq_rel)) {
+        std::function<void()> done = std::move(promise.on_done);
+        done();
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { error = std::current_exception(); }
+
+  /** Rethrow the coroutine's exception, if any */
+  void RethrowError() const {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+/** Promise of a Task producing a value */
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+  std::optional<T> value;
+
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U&& result) {
+    value.emplace(std::forward<U>(result));
+  }
+
+  T Result() {
+    RethrowError();
+    return std::move(*value);
+  }
+};
+
+/** Promise of a Task producing nothing */
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void Result() const { RethrowError(); }
+};
+
+} // namespace detail
+
+/**
+ * @class Task
+ * @brief Lazily started coroutine producing a T, the return type of coroutine handlers
+ *
+ * A coroutine returning Task runs nothing until it is awaited or started.
+ * Awaiting a Task from another Task runs it as part of the awaiting one and
+ * returns its result (or rethrows its exception); the awaiting coroutine
+ * resumes directly when it finishes, without going through a queue. The
+ * server starts a handler's task with Start() and, if it suspended, takes
+ * the result through Then() on whichever thread finishes it.
+ * @code
+ * Task<std::string> Lookup(int fd);
+ * Task<Response> Handle(const Request& request) {
+ *   std::string value = co_await Lookup(fd);
+ *   ...
+ * }
+ * @endcode
+ */
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+  using promise_type = detail::TaskPromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /** Empty task, owning no coroutine */
+  Task() = default;
+
+  /** Take ownership of a coroutine frame */
+  explicit Task(Handle handle) : handle_(handle) {}
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  // Disable copy
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  /** Destroy the coroutine frame, wherever it is suspended */
+  ~Task() { Destroy(); }
+
+  /** @return true if the task owns a coroutine */
+  explicit operator bool() const { return static_cast<bool>(handle_); }
+
+  /** Awaitable running the task as part of the awaiting coroutine */
+  struct Awaiter {
+    Handle handle;
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+      promise_type& promise = handle.promise();
+      promise.continuation = awaiting;
+      promise.executor = awaiting.promise().executor;
+      return handle;
+    }
+
+    T await_resume() { return handle.promise().Result(); }
+  };
+
+  /** Awaiting a task runs it as part of the awaiting coroutine */
+  Awaiter operator co_await() && noexcept { return Awaiter{handle_}; }
+
+  /**
+   * @brief Run the task until it first suspends or finishes
+   * @param executor Where its awaits wait and resume, null to make them block the calling thread
+   * @return true if it finished; Result() is then available, otherwise call Then()
+   */
+  bool Start(Executor* executor) {
+    handle_.promise().executor = executor;
+    handle_.resume();
+    return handle_.promise().finished.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Take the result of a finished task
+   * @return Value given to co_return, rethrows an exception that escaped the coroutine
+   */
+  T Result() { return handle_.promise().Result(); }
+
+  /**
+   * @brief Hand a started, suspended task to a completion
+   *
+   * done receives the task once it finished, on the thread that finished it,
+   * or right away if that already happened; the task's frame is destroyed
+   * with the Task done was given.
+   * @param done Completion
+   */
+  void Then(std::function<void(Task)> done) && {
+    Handle handle = std::exchange(handle_, nullptr);
+    handle.promise().on_done = [handle, done = std::move(done)] { done(Task(handle)); };
+    if (handle.promise().finished.exchange(true, std::memory_order_acq_rel)) {
+      std::function<void()> finish = std::move(handle.promise().on_done);
+      finish();
+    }
+  }
+
+private:
+  void Destroy() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace revak
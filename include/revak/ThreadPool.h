@@ -1,25 +1,36 @@
 /**
  * @file ThreadPool.h
  * @brief Server's thread pool for handling concurrent tasks.
- * 
+ *
  * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
  * Licensed under the MIT License. Part of the Revak project.
  */
 
-#include <vector>
-#include <queue>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
+#pragma once
+
+#include "Histogram.h"
+#include "MpmcQueue.h"
+#include "WorkStealingDeque.h"
+
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <future>
-#include <stdexcept>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace revak {
 
 /**
  * @class ThreadPool
- * @brief A simple thread pool implementation to manage a pool of worker threads
+ * @brief Work-stealing thread pool
+ *
+ * Every worker owns a Chase-Lev deque: tasks enqueued from a worker go to
+ * its own deque and are run LIFO while still hot in cache, and idle
+ * workers steal the oldest tasks of the others. Tasks enqueued from any
+ * other thread (the event loop, the acceptor) go through a lock-free
+ * injection queue. An idle worker spins briefly, then parks on an atomic
+ * wait until a producer signals new work.
  */
 class ThreadPool {
 public:
@@ -29,27 +40,146 @@ public:
    */
   explicit ThreadPool(size_t numThreads);
 
-  /** Destructor to join all threads */
+  /** Destructor to run the remaining tasks and join all threads */
   ~ThreadPool();
 
+  // Disable copy and assignment
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
   /** Enqueue a new task to the thread pool */
   void Enqueue(std::function<void()> task);
 
+  /**
+   * @brief Enqueue a task unless the pool is saturated
+   *
+   * Unlike Enqueue(), never waits: fails when the queue limit is reached or
+   * the injection queue is full. Work that was already admitted (follow-ups
+   * of a running task) should use Enqueue().
+   * @param task Task to run
+   * @return false if the task was rejected (and dropped)
+   */
+  bool TryEnqueue(std::function<void()> task);
+
+  /**
+   * @brief Set how many tasks may wait before TryEnqueue() rejects more
+   * @param limit Number of queued tasks (default is the injection queue capacity)
+   */
+  void SetQueueLimit(size_t limit);
+
+  /**
+   * @struct Stats
+   * @brief Load of the pool, see GetStats()
+   */
+  struct Stats {
+    /** Worker threads */
+    size_t threads{0};
+
+    /** Tasks waiting to run (approximate) */
+    size_t queued{0};
+
+    /** Tasks run so far */
+    uint64_t executed{0};
+
+    /** Time tasks waited between Enqueue() and their start, empty unless timed */
+    Histogram::Snapshot wait;
+  };
+
+  /**
+   * @brief Time how long tasks wait in the queues
+   *
+   * Costs two clock reads per task, so it is off by default.
+   * @param enabled true to start timing tasks enqueued from now on
+   */
+  void SetWaitTiming(bool enabled);
+
+  /** @return Queue length, tasks run and wait times, merged over the workers */
+  Stats GetStats() const;
+
 private:
-  /** Worker threads */
-  std::vector<std::thread> workers_;
+  /** A queued task with its enqueue time (0 when not timed) */
+  struct Task {
+    std::function<void()> function;
+    int64_t enqueued_ns;
+  };
 
-  /** Mutex for task queue */
-  std::mutex queue_mutex_;
+  /** Per-worker state */
+  struct Worker {
+    /** Tasks enqueued by this worker */
+    WorkStealingDeque<Task*> deque;
 
-  /** Flag to stop the pool */
-  bool stop_;
+    /** Seed of the victim selection */
+    uint32_t rng;
 
-  /** Task queue */
-  std::queue<std::function<void()>> tasks_;
+    /** Tasks run by this worker (written by it only) */
+    std::atomic<uint64_t> executed{0};
 
-  /** Condition variable for task notification */
-  std::condition_variable condition_;
+    /** Queue wait of the timed tasks this worker ran */
+    Histogram wait;
+  };
+
+  /**
+   * @brief Worker thread body
+   * @param index Index of the worker
+   */
+  void WorkerLoop(size_t index);
+
+  /**
+   * @brief Find a task: own deque, then injection queue, then steal
+   * @param index Index of the calling worker
+   * @return Task, nullptr if none was found
+   */
+  Task* FindTask(size_t index);
+
+  /** @return true if any queue looks non-empty */
+  bool HasWork() const;
+
+  /** @return Tasks waiting in every queue (approximate) */
+  size_t QueuedApprox() const;
+
+  /**
+   * @brief Put a task on the calling worker's deque, or the injection queue
+   * @param task Task to queue
+   * @param wait Wait for room in a full injection queue instead of failing
+   * @return false if the injection queue was full and wait was false (the task is dropped)
+   */
+  bool Push(std::function<void()> task, bool wait);
+
+  /** Wake one parked worker, if any */
+  void WakeOne();
+
+  /** Capacity of the injection queue */
+  static constexpr size_t kInjectionCapacity = 1 << 16;
+
+  /** Rounds of FindTask before a worker parks */
+  static constexpr int kSpinRounds = 32;
+
+  /** Leading spin rounds that pause instead of yielding */
+  static constexpr int kPauseRounds = 16;
+
+  /** Per-worker deques, indexed like workers_ */
+  std::vector<std::unique_ptr<Worker>> states_;
+
+  /** Tasks enqueued from outside the pool */
+  MpmcQueue<Task*> injection_;
+
+  /** Bumped on every wake-up so parked workers leave their wait */
+  std::atomic<uint32_t> wake_epoch_{0};
+
+  /** Number of parked (or about to park) workers */
+  std::atomic<int> sleepers_{0};
+
+  /** Queued tasks beyond which TryEnqueue() rejects */
+  std::atomic<size_t> queue_limit_{kInjectionCapacity};
+
+  /** Whether Enqueue() stamps tasks for the wait histogram */
+  std::atomic<bool> time_waits_{false};
+
+  /** Flag to stop the pool */
+  std::atomic<bool> stop_{false};
+
+  /** Worker threads */
+  std::vector<std::thread> workers_;
 };
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
@@ -0,0 +1,197 @@
+/**
+ * @file TimerWheel.h
+ * @brief TimerWheel class declaration
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace revak {
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timing wheel holding the timers of one event loop, driven by a single timerfd
+ *
+ * Timers hang in kSlots lists picked by their deadline in ticks modulo
+ * kSlots (Varghese and Lauck's scheme 6): arming, re-arming and cancelling
+ * are O(1) however many timers there are, and the slot a timer waits in is
+ * only looked at when the wheel's hand reaches it. Timers are intrusive
+ * nodes owned by their users, so arming one allocates nothing.
+ *
+ * Moving an armed timer's deadline later only records the new deadline; the
+ * timer moves to its new slot when its old one comes round. Re-arming on
+ * every read therefore costs a clock read and a store. The timerfd is set
+ * for the next occupied slot, not for every tick, so a loop whose timers
+ * are far away is not woken. Timers fire on their tick or later, never
+ * earlier. Loop thread only.
+ */
+class TimerWheel {
+public:
+  /** Resolution of the deadlines */
+  static constexpr std::chrono::milliseconds kTick{1};
+
+  /** Lists in the wheel; one revolution spans kSlots ticks */
+  static constexpr size_t kSlots = 4096;
+
+  /**
+   * @class Timer
+   * @brief A callback the wheel runs at a deadline, linked into one of its slots while armed
+   */
+  class Timer {
+  public:
+    Timer() = default;
+
+    /**
+     * @brief Create a disarmed timer
+     * @param callback Run when the timer expires; it may destroy the timer
+     */
+    explicit Timer(std::function<void()> callback) : callback_(std::move(callback)) {}
+
+    /** Cancels the timer if it is armed */
+    ~Timer();
+
+    // Disable copy and assignment, the wheel links to the timer's address
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    /** @param callback Run when the timer expires; it may destroy the timer */
+    void SetCallback(std::function<void()> callback) { callback_ = std::move(callback); }
+
+    /** @return true while the timer waits in a wheel */
+    bool IsArmed() const { return wheel_ != nullptr; }
+
+  private:
+    friend class TimerWheel;
+
+    /** Wheel the timer is armed in, null when disarmed */
+    TimerWheel* wheel_{nullptr};
+
+    /** Next timer of the same list */
+    Timer* next_{nullptr};
+
+    /** Link pointing at this timer: the list head or the previous timer's next_ */
+    Timer** link_{nullptr};
+
+    /** Slot the timer is linked into */
+    size_t slot_{0};
+
+    /** Tick at which the timer expires, possibly past its slot's after a lazy re-arm */
+    uint64_t deadline_{0};
+
+    /** Run on expiry */
+    std::function<void()> callback_;
+
+    /** True for the timers of RunAfter(), deleted once they ran */
+    bool owned_{false};
+  };
+
+  /** Create the wheel and its timerfd */
+  TimerWheel();
+
+  /** Disarm every timer, deleting those of RunAfter() that did not run */
+  ~TimerWheel();
+
+  // Disable copy and assignment
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /**
+   * @brief Arm a timer, or move the deadline of an armed one
+   * @param timer Timer to arm
+   * @param delay Time from now until the timer expires
+   */
+  void Arm(Timer& timer, std::chrono::milliseconds delay);
+
+  /**
+   * @brief Disarm a timer; nothing happens if it is not armed
+   * @param timer Timer to cancel
+   */
+  void Cancel(Timer& timer);
+
+  /**
+   * @brief Run a task once after a delay, with a timer owned by the wheel
+   * @param delay Time before the run
+   * @param task Task to execute
+   * @return true if the timer was armed, false if the wheel has no timerfd
+   */
+  bool RunAfter(std::chrono::milliseconds delay, std::function<void()> task);
+
+  /** Run the timers whose deadline passed; call it when the timerfd is readable */
+  void Expire();
+
+  /** @return File descriptor of the timerfd, readable when timers are due */
+  [[nodiscard]] int NativeHandle() const { return timer_fd_; }
+
+private:
+  /** @return Current tick, counted from the creation of the wheel */
+  uint64_t NowTick() const;
+
+  /**
+   * @brief Link a timer at the head of a list
+   * @param head Head of the list
+   * @param timer Disarmed timer
+   */
+  static void Push(Timer*& head, Timer& timer);
+
+  /**
+   * @brief Unlink a timer from the list it is in
+   * @param timer Linked timer
+   */
+  static void Unlink(Timer& timer);
+
+  /**
+   * @brief Link a timer into the slot of its deadline
+   * @param timer Unlinked timer with its deadline set
+   */
+  void Insert(Timer& timer);
+
+  /**
+   * @brief Run the due timers of a slot and move the others where their deadline belongs
+   * @param slot Slot the hand reached
+   * @param now Current tick
+   */
+  void ExpireSlot(size_t slot, uint64_t now);
+
+  /** Set the timerfd for the next occupied slot, or disarm it */
+  void ScheduleNext();
+
+  /**
+   * @brief Set the timerfd for a tick
+   * @param tick Tick to wake up at, already passed ones fire at once
+   */
+  void Schedule(uint64_t tick);
+
+  /** Tick the timerfd is set for when it is disarmed */
+  static constexpr uint64_t kNever = UINT64_MAX;
+
+  /** timerfd waking the loop when a slot is due */
+  int timer_fd_{-1};
+
+  /** CLOCK_MONOTONIC time of tick 0, in nanoseconds */
+  int64_t origin_ns_{0};
+
+  /** Last tick whose slot was expired */
+  uint64_t current_{0};
+
+  /** Tick the timerfd is set for */
+  uint64_t scheduled_{kNever};
+
+  /** True while Expire() runs callbacks; it sets the timerfd once they are done */
+  bool expiring_{false};
+
+  /** Lists of timers, indexed by deadline modulo kSlots */
+  std::array<Timer*, kSlots> slots_{};
+
+  /** One bit per slot holding timers */
+  std::array<uint64_t, kSlots / 64> occupied_{};
+};
+
+} // namespace revak
@@ -0,0 +1,165 @@
+/**
+ * @file WorkStealingDeque.h
+ * @brief Chase-Lev work-stealing deque
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace revak {
+
+/**
+ * @class WorkStealingDeque
+ * @brief Lock-free Chase-Lev deque of pointers (Lê et al., PPoPP 2013)
+ *
+ * The owning thread pushes and takes at the bottom (LIFO, cache friendly)
+ * while any other thread may steal from the top (FIFO). The ring grows
+ * when full; replaced rings are kept until the deque is destroyed because
+ * a concurrent thief may still be reading from them.
+ * @tparam T Pointer type stored in the deque
+ */
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_pointer_v<T>, "WorkStealingDeque stores pointers");
+
+public:
+  /**
+   * @brief Create an empty deque
+   * @param capacity Initial ring capacity, must be a power of two
+   */
+  explicit WorkStealingDeque(size_t capacity = 1024) {
+    rings_.push_back(std::make_unique<Ring>(capacity));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  // Disable copy and assignment
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * @brief Push an item at the bottom (owner thread only)
+   * @param item Item to push
+   */
+  void Push(T item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<int64_t>(ring->mask)) {
+      ring = Grow(ring, top, bottom);
+    }
+    ring->Put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Take the most recently pushed item (owner thread only)
+   * @return Item, nullptr if the deque is empty
+   */
+  T Take() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T item = ring->Get(bottom);
+    if (top == bottom) {
+      // Last item: race the thieves for it
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /**
+   * @brief Steal the oldest item (any thread)
+   * @return Item, nullptr if the deque is empty or another thread won the race
+   */
+  T Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    T item = ring->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  /** @return true if the deque looked empty at the time of the call */
+  bool Empty() const {
+    return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+  }
+
+  /** @return Number of items at the time of the call, approximate under concurrent use */
+  size_t SizeApprox() const {
+    int64_t size = bottom_.load(std::memory_order_acquire) - top_.load(std::memory_order_acquire);
+    return size > 0 ? static_cast<size_t>(size) : 0;
+  }
+
+private:
+  /** Power-of-two ring of atomic slots */
+  struct Ring {
+    explicit Ring(size_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+    void Put(int64_t index, T item) {
+      slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+    }
+
+    T Get(int64_t index) const {
+      return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  /** Double the ring, copying the live items (owner thread only) */
+  Ring* Grow(Ring* ring, int64_t top, int64_t bottom) {
+    auto bigger = std::make_unique<Ring>((ring->mask + 1) * 2);
+    for (int64_t i = top; i < bottom; ++i) {
+      bigger->Put(i, ring->Get(i));
+    }
+    Ring* raw = bigger.get();
+    rings_.push_back(std::move(bigger));
+    ring_.store(raw, std::memory_order_release);
+    return raw;
+  }
+
+  /** Index of the next item to steal */
+  alignas(64) std::atomic<int64_t> top_{0};
+
+  /** Index one past the most recently pushed item */
+  alignas(64) std::atomic<int64_t> bottom_{0};
+
+  /** Current ring */
+  std::atomic<Ring*> ring_{nullptr};
+
+  /** Current and retired rings (owner thread only) */
+  std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+} // namespace revak
@@ -9,18 +9,79 @@
 #include "revak/Server.h"
 #include "revak/Logger.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <format>
+
 int main() {
-	revak::Server server(8080, 4);
+	revak::Server server(8080, 4, revak::IoMode::EPOLL);
 
 	server.Get("/hello", [](const revak::Request& req) {
 		revak::Response res;
 		res.SetStatus(200);
-		res.SetBody(req.Method() + " " + req.Path() + " says Hello, World!\n");
+		res.SetBody(std::format("{} {} says Hello, World!\n", req.Method(), req.Path()));
 		res.SetHeader("Content-Type", "text/plain");
-		res.SetHeader("Connection", "close");
 		return res;
 	});
 	
+	server.Get("/hello/:name", [](const revak::Request& req) {
+		revak::Response res;
+		res.SetStatus(200);
+		res.SetBody(std::format("Hello, {}!\n", req.Param("name")));
+		res.SetHeader("Content-Type", "text/plain");
+		return res;
+	});
+
+	// Cached for a minute: repeated hits skip the handler, ETag and 304 come for free
+	server.Get("/time", [](const revak::Request&) {
+		revak::Response res;
+		res.SetStatus(200);
+		res.SetBody(std::format("Rendered at {}\n", std::time(nullptr)));
+		res.SetHeader("Content-Type", "text/plain");
+		return res;
+	}, {.ttl = std::chrono::minutes(1)});
+
+	server.Post("/echo", [](const revak::Request& req) {
+		revak::Response res;
+		res.SetStatus(200);
+		res.SetBody(std::string(req.Body()));
+		res.SetHeader("Content-Type", "application/octet-stream");
+		return res;
+	});
+
+	// Streamed with chunked encoding, one line at a time
+	server.Get("/count/:n", [](const revak::Request& req) {
+		revak::Response res;
+		res.SetStatus(200);
+		res.SetHeader("Content-Type", "text/plain");
+		int limit = std::atoi(std::string(req.Param("n")).c_str());
+		res.SetStreamBody([i = 0, limit](std::string& chunk) mutable {
+			if (i < limit) {
+				chunk += std::format("{}\n", ++i);
+			}
+			return i < limit;
+		});
+		return res;
+	});
+
+	// Coroutine handler: waits without holding a worker, thousands can be in flight
+	server.Get("/delay/:ms", [](const revak::Request& req) -> revak::Task<revak::Response> {
+		int ms = std::atoi(std::string(req.Param("ms")).c_str());
+		co_await revak::Sleep(std::chrono::milliseconds(ms));
+		revak::Response res;
+		res.SetStatus(200);
+		res.SetBody(std::format("Waited {} ms\n", ms));
+		res.SetHeader("Content-Type", "text/plain");
+		co_return res;
+	});
+
+	// Files below ./public, e.g. GET /static/index.html
+	server.Static("/static", "./public");
+
+	// Prometheus metrics: per-route counts and latencies, connections, thread pool
+	server.EnableMetrics();
+
 	server.Run();
 	return 0;
 }
\ No newline at end of file
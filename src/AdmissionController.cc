@@ -0,0 +1,59 @@
+/**
+ * @file AdmissionController.cc
+ * @brief AdmissionController class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/AdmissionController.h"
+
+namespace revak {
+
+namespace {
+
+/** Monotonic time in nanoseconds */
+inline int64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+AdmissionController::AdmissionController(std::chrono::milliseconds target, std::chrono::milliseconds interval)
+  : target_ns_(std::chrono::nanoseconds(target).count()), interval_ns_(std::chrono::nanoseconds(interval).count()) {}
+
+void AdmissionController::SetTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval) {
+  target_ns_.store(std::chrono::nanoseconds(target).count(), std::memory_order_relaxed);
+  interval_ns_.store(std::chrono::nanoseconds(interval).count(), std::memory_order_relaxed);
+  overloaded_.store(false, std::memory_order_relaxed);
+}
+
+bool AdmissionController::Admit(std::chrono::nanoseconds delay) {
+  int64_t target = target_ns_.load(std::memory_order_relaxed);
+  if (target <= 0) {
+    return true;
+  }
+
+  // The thread that closes an interval judges it: overloaded if the queue never drained below the target
+  int64_t now = NowNanoseconds();
+  int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+  int64_t interval_end = interval_end_ns_.load(std::memory_order_relaxed);
+  if (now >= interval_end &&
+      interval_end_ns_.compare_exchange_strong(interval_end, now + interval, std::memory_order_relaxed)) {
+    int64_t min_delay = min_delay_ns_.exchange(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+    // An interval without samples saw no queue, and a minimum older than the interval
+    // that just ended (the first call, or after idling) says nothing about the load now
+    bool ended_now = now < interval_end + interval;
+    bool sampled = min_delay != std::numeric_limits<int64_t>::max();
+    overloaded_.store(ended_now && sampled && min_delay > target, std::memory_order_relaxed);
+  }
+
+  int64_t delay_ns = delay.count();
+  int64_t min_delay = min_delay_ns_.load(std::memory_order_relaxed);
+  while (delay_ns < min_delay &&
+         !min_delay_ns_.compare_exchange_weak(min_delay, delay_ns, std::memory_order_relaxed)) {}
+
+  return !(overloaded_.load(std::memory_order_relaxed) && delay_ns > 2 * target);
+}
+
+} // namespace revak
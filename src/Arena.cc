@@ -0,0 +1,81 @@
+/**
+ * @file Arena.cc
+ * @brief Arena class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include <revak/Arena.h>
+
+#include <algorithm>
+
+namespace revak {
+
+namespace {
+
+/** Resource of the request being handled on this thread, null outside a scope */
+thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+} // namespace
+
+void Arena::Reset() {
+  // Keep the leading blocks up to the retained size, free the rest
+  size_t kept = 0;
+  size_t retained = 0;
+  while (kept < blocks_.size() && retained + blocks_[kept].size <= kRetainedBytes) {
+    retained += blocks_[kept].size;
+    ++kept;
+  }
+  blocks_.resize(kept);
+  current_ = 0;
+  offset_ = 0;
+}
+
+size_t Arena::Capacity() const {
+  size_t capacity = 0;
+  for (const Block& block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+  while (current_ < blocks_.size()) {
+    Block& block = blocks_[current_];
+    void* cursor = block.data.get() + offset_;
+    size_t space = block.size - offset_;
+    if (std::align(alignment, bytes, cursor, space) != nullptr) {
+      offset_ = static_cast<size_t>(static_cast<std::byte*>(cursor) - block.data.get()) + bytes;
+      return cursor;
+    }
+    ++current_;
+    offset_ = 0;
+  }
+
+  // Out of blocks: add one at least twice the last, large enough for the request
+  size_t size = blocks_.empty() ? block_size_ : blocks_.back().size * 2;
+  size = std::max(size, bytes + alignment);
+  blocks_.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+  current_ = blocks_.size() - 1;
+
+  void* cursor = blocks_.back().data.get();
+  size_t space = size;
+  std::align(alignment, bytes, cursor, space);
+  offset_ = static_cast<size_t>(static_cast<std::byte*>(cursor) - blocks_.back().data.get()) + bytes;
+  return cursor;
+}
+
+std::pmr::memory_resource* CurrentMemoryResource() {
+  return current_resource != nullptr ? current_resource : std::pmr::get_default_resource();
+}
+
+MemoryResourceScope::MemoryResourceScope(std::pmr::memory_resource* resource) : previous_(current_resource) {
+  current_resource = resource;
+}
+
+MemoryResourceScope::~MemoryResourceScope() {
+  current_resource = previous_;
+}
+
+} // namespace revak
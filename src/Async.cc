@@ -0,0 +1,113 @@
+/**
+ * @file Async.cc
+ * @brief Executor class and awaitable operations implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/Async.h"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <cerrno>
+#include <thread>
+
+namespace revak {
+
+void Executor::Resume(std::coroutine_handle<> handle, std::pmr::memory_resource* memory) const {
+  schedule_([handle, memory] {
+    MemoryResourceScope memory_scope(memory);
+    handle.resume();
+  });
+}
+
+namespace detail {
+
+bool SuspendFor(std::chrono::milliseconds duration, std::coroutine_handle<> handle, TaskPromiseBase& promise) {
+  Executor* executor = promise.executor;
+  if (executor == nullptr) {
+    std::this_thread::sleep_for(duration);
+    return false;
+  }
+
+  // Timers belong to the loop thread; the coroutine stays suspended until the loop resumes it
+  std::pmr::memory_resource* memory = promise.memory;
+  executor->Loop().Post([executor, duration, handle, memory] {
+    if (!executor->Loop().RunAfter(duration, [executor, handle, memory] { executor->Resume(handle, memory); })) {
+      executor->Resume(handle, memory);
+    }
+  });
+  return true;
+}
+
+bool SuspendUntilReady(int fd, uint32_t events, std::coroutine_handle<> handle, TaskPromiseBase& promise) {
+  Executor* executor = promise.executor;
+  if (executor == nullptr) {
+    pollfd ready{fd, static_cast<short>(events), 0};
+    while (::poll(&ready, 1, -1) < 0 && errno == EINTR) {}
+    return false;
+  }
+
+  // Watched only until the first event: the handler retries its call and waits again if needed
+  std::pmr::memory_resource* memory = promise.memory;
+  executor->Loop().Post([executor, fd, events, handle, memory] {
+    EventLoop& loop = executor->Loop();
+    bool added = loop.Add(fd, events | EPOLLRDHUP, [&loop, executor, fd, handle, memory](uint32_t) {
+      loop.Remove(fd);
+      executor->Resume(handle, memory);
+    });
+    if (!added) {
+      executor->Resume(handle, memory);
+    }
+  });
+  return true;
+}
+
+} // namespace detail
+
+ReadyAwaiter Readable(int fd) {
+  return ReadyAwaiter(fd, EPOLLIN);
+}
+
+ReadyAwaiter Writable(int fd) {
+  return ReadyAwaiter(fd, EPOLLOUT);
+}
+
+Task<ssize_t> Receive(int fd, void* buffer, size_t size) {
+  while (true) {
+    ssize_t received = ::recv(fd, buffer, size, MSG_DONTWAIT);
+    if (received >= 0) {
+      co_return received;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      co_return -1;
+    }
+    co_await Readable(fd);
+  }
+}
+
+Task<ssize_t> Send(int fd, const void* data, size_t size) {
+  size_t sent = 0;
+  while (sent < size) {
+    ssize_t written = ::send(fd, static_cast<const char*>(data) + sent, size - sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (written >= 0) {
+      sent += static_cast<size_t>(written);
+      continue;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      co_return -1;
+    }
+    co_await Writable(fd);
+  }
+  co_return static_cast<ssize_t>(sent);
+}
+
+} // namespace revak
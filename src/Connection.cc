@@ -0,0 +1,314 @@
+/**
+ * @file Connection.cc
+ * @brief Connection class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/Connection.h"
+
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <charconv>
+
+namespace revak {
+
+namespace {
+
+/** Size of the stack buffer used for each read() call */
+constexpr size_t kReadChunkSize = 16384;
+
+/** Most buffers handed to one sendmsg() call (well under IOV_MAX) */
+constexpr size_t kMaxIovecs = 64;
+
+/** Streamed pieces are gathered until a chunk has at least this many bytes */
+constexpr size_t kMinStreamChunk = 16384;
+
+} // namespace
+
+Connection::Connection(Socket socket, RequestParser::Limits limits)
+  : socket_(std::move(socket)), parser_(limits) {}
+
+void Connection::CompactInput() {
+  if (input_offset_ > 0) {
+    input_.erase(0, input_offset_);
+    input_offset_ = 0;
+  }
+}
+
+Connection::IoStatus Connection::ReadAvailable(size_t max_input) {
+  CompactInput();
+  char buffer[kReadChunkSize];
+  while (true) {
+    // One fast sender must neither hold the loop thread nor grow the buffer without bound
+    if (input_.size() >= max_input) {
+      return IoStatus::FULL;
+    }
+    ssize_t bytes_read = ::recv(socket_.NativeHandle(), buffer, sizeof(buffer), 0);
+    if (bytes_read > 0) {
+      input_.append(buffer, static_cast<size_t>(bytes_read));
+      continue;
+    }
+    if (bytes_read == 0) {
+      return IoStatus::CLOSED;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return IoStatus::OK;
+    }
+    return IoStatus::ERROR;
+  }
+}
+
+void Connection::AppendInput(std::string_view data) {
+  CompactInput();
+  input_.append(data);
+}
+
+Connection::IoStatus Connection::ReadOnce() {
+  CompactInput();
+  char buffer[kReadChunkSize];
+  while (true) {
+    ssize_t bytes_read = ::recv(socket_.NativeHandle(), buffer, sizeof(buffer), 0);
+    if (bytes_read > 0) {
+      input_.append(buffer, static_cast<size_t>(bytes_read));
+      return IoStatus::OK;
+    }
+    if (bytes_read == 0) {
+      return IoStatus::CLOSED;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    // EAGAIN on a blocking socket means SO_RCVTIMEO expired
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return IoStatus::TIMEOUT;
+    }
+    return IoStatus::ERROR;
+  }
+}
+
+Connection::IoStatus Connection::Flush() {
+  while (flush_index_ < pending_.size()) {
+    const PendingResponse& current = pending_[flush_index_];
+
+    // Streamed bodies are sent one pulled piece at a time
+    if (current.response.IsStreamed() && flush_offset_ >= current.head_length) {
+      if (stream_offset_ < stream_buffer_.size()) {
+        ssize_t sent = ::send(socket_.NativeHandle(), stream_buffer_.data() + stream_offset_,
+                              stream_buffer_.size() - stream_offset_, MSG_NOSIGNAL);
+        if (sent < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IoStatus::OK;
+          }
+          return errno == EPIPE || errno == ECONNRESET ? IoStatus::CLOSED : IoStatus::ERROR;
+        }
+        stream_offset_ += static_cast<size_t>(sent);
+        continue;
+      }
+      if (!stream_finished_) {
+        return IoStatus::OK; // Sent everything pulled so far, see NeedsStreamData()
+      }
+      stream_buffer_.clear();
+      stream_offset_ = 0;
+      stream_finished_ = false;
+      ++flush_index_;
+      flush_offset_ = 0;
+      continue;
+    }
+
+    // File bodies go from the page cache straight to the socket
+    const FileRegion* file = current.response.GetFileBody();
+    if (file != nullptr && flush_offset_ >= current.head_length) {
+      size_t done = flush_offset_ - current.head_length;
+      auto offset = static_cast<off_t>(file->offset + done);
+      ssize_t sent = ::sendfile(socket_.NativeHandle(), file->file->NativeHandle(), &offset, file->length - done);
+      if (sent < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return IoStatus::OK;
+        }
+        return errno == EPIPE || errno == ECONNRESET ? IoStatus::CLOSED : IoStatus::ERROR;
+      }
+      if (sent == 0) {
+        return IoStatus::ERROR; // File shrank under us, Content-Length can no longer be honored
+      }
+      AdvanceOutput(static_cast<size_t>(sent));
+      continue;
+    }
+
+    iovec iov[kMaxIovecs];
+    bool file_follows = false;
+    size_t count = GatherOutput(iov, kMaxIovecs, file_follows);
+
+    // sendmsg is writev with flags: MSG_NOSIGNAL keeps a vanished peer from raising SIGPIPE,
+    // MSG_MORE lets a head share its packet with the file data sent next
+    msghdr message{};
+    message.msg_iov = iov;
+    message.msg_iovlen = count;
+    ssize_t written = ::sendmsg(socket_.NativeHandle(), &message, MSG_NOSIGNAL | (file_follows ? MSG_MORE : 0));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return IoStatus::OK;
+      }
+      return errno == EPIPE || errno == ECONNRESET ? IoStatus::CLOSED : IoStatus::ERROR;
+    }
+    AdvanceOutput(static_cast<size_t>(written));
+  }
+
+  ClearSentOutput();
+  return IoStatus::OK;
+}
+
+size_t Connection::GatherOutput(iovec* iov, size_t max_count, bool& file_follows) const {
+  // Gather heads and bodies of as many responses as one call can take,
+  // stopping after the head of a response whose body is a file or a stream
+  size_t count = 0;
+  size_t skip = flush_offset_;
+  file_follows = false;
+  for (size_t i = flush_index_; i < pending_.size() && count + 2 <= max_count; ++i) {
+    const PendingResponse& entry = pending_[i];
+
+    if (skip < entry.head_length) {
+      iov[count++] = {const_cast<char*>(head_buffer_.data()) + entry.head_offset + skip, entry.head_length - skip};
+      skip = 0;
+    } else {
+      skip -= entry.head_length;
+    }
+    if (entry.response.GetFileBody() != nullptr) {
+      file_follows = true;
+      break;
+    }
+    if (entry.response.IsStreamed()) {
+      break;
+    }
+    std::string_view body = entry.response.GetBody();
+    if (skip < body.size()) {
+      iov[count++] = {const_cast<char*>(body.data()) + skip, body.size() - skip};
+    }
+    skip = 0;
+  }
+  return count;
+}
+
+void Connection::CompleteOutput(size_t bytes) {
+  AdvanceOutput(bytes);
+  if (flush_index_ >= pending_.size()) {
+    ClearSentOutput();
+  }
+}
+
+void Connection::ClearSentOutput() {
+  if (!pending_.empty()) {
+    pending_.clear();
+    head_buffer_.clear(); // Keeps its capacity for the next batch
+    flush_index_ = 0;
+    flush_offset_ = 0;
+  }
+}
+
+void Connection::AdvanceOutput(size_t bytes) {
+  // Short writes are normal: advance through the responses by the bytes sent
+  while (bytes > 0 && flush_index_ < pending_.size()) {
+    const PendingResponse& entry = pending_[flush_index_];
+    size_t left = entry.head_length + entry.response.BodySize() - flush_offset_;
+    if (bytes < left) {
+      flush_offset_ += bytes;
+      return;
+    }
+    if (entry.response.IsStreamed()) {
+      // Only the head was gathered; the body is pulled and sent by Flush()
+      flush_offset_ = entry.head_length;
+      return;
+    }
+    bytes -= left;
+    ++flush_index_;
+    flush_offset_ = 0;
+  }
+}
+
+bool Connection::NeedsStreamData() const {
+  if (flush_index_ >= pending_.size()) {
+    return false;
+  }
+  const PendingResponse& current = pending_[flush_index_];
+  return current.response.IsStreamed() && flush_offset_ >= current.head_length &&
+         stream_offset_ == stream_buffer_.size() && !stream_finished_;
+}
+
+void Connection::PullStreamData() {
+  Response& response = pending_[flush_index_].response;
+  stream_chunk_.clear();
+
+  // Coalesce small pieces so each write (and each pool round trip) carries a useful amount
+  bool more = true;
+  while (more && stream_chunk_.size() < kMinStreamChunk) {
+    more = response.NextChunk(stream_chunk_);
+  }
+
+  stream_buffer_.clear();
+  stream_offset_ = 0;
+  if (response.IsChunked()) {
+    // An empty chunk would end the body early, so only the last one may be empty
+    if (!stream_chunk_.empty()) {
+      char size[16];
+      auto result = std::to_chars(size, size + sizeof(size), stream_chunk_.size(), 16);
+      stream_buffer_.append(size, result.ptr);
+      stream_buffer_ += "\r\n";
+      stream_buffer_ += stream_chunk_;
+      stream_buffer_ += "\r\n";
+    }
+    if (!more) {
+      stream_buffer_ += "0\r\n\r\n";
+    }
+  } else {
+    stream_buffer_.swap(stream_chunk_);
+  }
+  stream_finished_ = !more;
+}
+
+Connection::Wait Connection::Waiting() const {
+  if (busy_) {
+    return Wait::NONE;
+  }
+  if (HasPendingOutput()) {
+    return Wait::OUTPUT;
+  }
+  if (input_offset_ < input_.size()) {
+    return parser_.InBody() ? Wait::BODY : Wait::HEADERS;
+  }
+  return Wait::IDLE;
+}
+
+RequestParser::Result Connection::NextRequest(Request& request) {
+  std::string_view pending = std::string_view(input_).substr(input_offset_);
+
+  RequestParser::Result result = parser_.Parse(pending);
+  if (result == RequestParser::Result::COMPLETE) {
+    parser_.Fill(pending, request);
+    input_offset_ += parser_.RequestSize();
+    parser_.Reset();
+  }
+  return result;
+}
+
+void Connection::QueueResponse(Response response) {
+  size_t head_offset = head_buffer_.size();
+  response.SerializeHead(head_buffer_);
+  pending_.push_back({std::move(response), head_offset, head_buffer_.size() - head_offset});
+}
+
+} // namespace revak
@@ -0,0 +1,113 @@
+/**
+ * @file DateCache.cc
+ * @brief DateCache class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/DateCache.h"
+
+#include <cstring>
+#include <ctime>
+
+namespace revak {
+
+namespace {
+
+constexpr const char* kDayNames[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+constexpr const char* kMonthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                       "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+/** Current wall clock second; the coarse clock is enough at one second resolution */
+int64_t CurrentSecond() {
+  timespec ts{};
+  ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+  return static_cast<int64_t>(ts.tv_sec);
+}
+
+/** Write two decimal digits */
+void PutTwoDigits(char* out, int value) {
+  out[0] = static_cast<char>('0' + value / 10);
+  out[1] = static_cast<char>('0' + value % 10);
+}
+
+} // namespace
+
+DateCache& DateCache::Instance() {
+  static DateCache instance;
+  return instance;
+}
+
+void DateCache::Append(std::string& out) {
+  const int64_t now = CurrentSecond();
+  uint64_t words[kWords];
+
+  while (true) {
+    uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      continue; // A refresh is being published
+    }
+    // Only move forward: a reader that sampled the clock late keeps the newer date
+    if (now > second_.load(std::memory_order_relaxed)) {
+      Refresh(now);
+      continue;
+    }
+
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == sequence) {
+      break;
+    }
+  }
+
+  out.append(reinterpret_cast<const char*>(words), kDateLength);
+}
+
+void DateCache::Format(int64_t second, char* out) {
+  // gmtime_r instead of gmtime (shared static buffer), and fixed English
+  // names instead of strftime, whose %a and %b follow the process locale
+  time_t time = static_cast<time_t>(second);
+  std::tm utc{};
+  ::gmtime_r(&time, &utc);
+
+  std::memcpy(out, kDayNames[utc.tm_wday], 3);
+  std::memcpy(out + 3, ", ", 2);
+  PutTwoDigits(out + 5, utc.tm_mday);
+  out[7] = ' ';
+  std::memcpy(out + 8, kMonthNames[utc.tm_mon], 3);
+  out[11] = ' ';
+  int year = utc.tm_year + 1900;
+  PutTwoDigits(out + 12, year / 100);
+  PutTwoDigits(out + 14, year % 100);
+  out[16] = ' ';
+  PutTwoDigits(out + 17, utc.tm_hour);
+  out[19] = ':';
+  PutTwoDigits(out + 20, utc.tm_min);
+  out[22] = ':';
+  PutTwoDigits(out + 23, utc.tm_sec);
+  std::memcpy(out + 25, " GMT", 4);
+}
+
+void DateCache::Refresh(int64_t second) {
+  uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  if ((sequence & 1) || !sequence_.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+    return; // Another thread is refreshing
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  char date[kWords * 8] = {};
+  Format(second, date);
+
+  for (size_t i = 0; i < kWords; ++i) {
+    uint64_t word;
+    std::memcpy(&word, date + i * 8, sizeof(word));
+    words_[i].store(word, std::memory_order_relaxed);
+  }
+  second_.store(second, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+} // namespace revak
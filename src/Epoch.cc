@@ -0,0 +1,125 @@
+/**
+ * @file Epoch.cc
+ * @brief Epoch class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/Epoch.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace revak {
+
+struct alignas(64) Epoch::Slot {
+  /** Epoch the thread entered its outermost guard in, kIdle outside of guards */
+  std::atomic<uint64_t> epoch{kIdle};
+
+  /** Set when the thread exited; the slot is dropped by the next Collect() */
+  std::atomic<bool> orphaned{false};
+};
+
+struct Epoch::ThreadSlot {
+  ~ThreadSlot() {
+    if (slot) {
+      slot->epoch.store(kIdle, std::memory_order_release);
+      slot->orphaned.store(true, std::memory_order_release);
+    }
+  }
+
+  std::shared_ptr<Slot> slot;
+
+  /** Guards the thread is in, only the outermost one announces an epoch */
+  size_t depth{0};
+};
+
+Epoch::Guard::Guard() : local_(LocalSlot()) {
+  if (local_.depth++ == 0) {
+    local_.slot->epoch.store(Instance().global_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    // The announcement must be visible before the pointer is read, see Collect()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+Epoch::Guard::~Guard() {
+  if (--local_.depth == 0) {
+    local_.slot->epoch.store(kIdle, std::memory_order_release);
+  }
+}
+
+Epoch& Epoch::Instance() {
+  static Epoch instance;
+  return instance;
+}
+
+Epoch::~Epoch() {
+  for (Retired& retired : retired_) {
+    retired.reclaim();
+  }
+}
+
+void Epoch::Retire(std::function<void()> reclaim) {
+  std::vector<std::function<void()>> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.push_back({global_.load(std::memory_order_relaxed), std::move(reclaim)});
+    ready = Collect();
+  }
+  // Outside of the mutex, a reclamation may destroy handlers that retire something themselves
+  for (std::function<void()>& free : ready) {
+    free();
+  }
+}
+
+size_t Epoch::Pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return retired_.size();
+}
+
+Epoch::ThreadSlot& Epoch::LocalSlot() {
+  thread_local ThreadSlot local;
+  if (!local.slot) {
+    local.slot = std::make_shared<Slot>();
+    Epoch& epoch = Instance();
+    std::lock_guard<std::mutex> lock(epoch.mutex_);
+    epoch.slots_.push_back(local.slot);
+  }
+  return local;
+}
+
+std::vector<std::function<void()>> Epoch::Collect() {
+  // Pairs with the fence of Guard: a reader whose announcement is not seen below
+  // reads the pointer after it was replaced, so it cannot hold what was retired
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  std::erase_if(slots_, [](const std::shared_ptr<Slot>& slot) {
+    return slot->orphaned.load(std::memory_order_acquire);
+  });
+
+  // Two advances free everything retired so far when no reader is in a guard
+  uint64_t epoch = global_.load(std::memory_order_relaxed);
+  for (int advance = 0; advance < 2; ++advance) {
+    bool behind = std::any_of(slots_.begin(), slots_.end(), [epoch](const std::shared_ptr<Slot>& slot) {
+      uint64_t announced = slot->epoch.load(std::memory_order_acquire);
+      return announced != kIdle && announced != epoch;
+    });
+    if (behind) {
+      break;
+    }
+    global_.store(++epoch, std::memory_order_seq_cst);
+  }
+
+  std::vector<std::function<void()>> ready;
+  auto safe = std::partition(retired_.begin(), retired_.end(), [epoch](const Retired& retired) {
+    return retired.epoch + 2 > epoch;
+  });
+  for (auto it = safe; it != retired_.end(); ++it) {
+    ready.push_back(std::move(it->reclaim));
+  }
+  retired_.erase(safe, retired_.end());
+  return ready;
+}
+
+}  // namespace revak
@@ -0,0 +1,195 @@
+/**
+ * @file EventLoop.cc
+ * @brief EventLoop class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/EventLoop.h"
+#include "revak/Logger.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace revak {
+
+namespace {
+
+/** Maximum number of events fetched by one epoll_wait call */
+constexpr int kMaxEvents = 256;
+
+} // namespace
+
+EventLoop::EventLoop() {
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to create epoll instance: " + std::string(std::strerror(errno)));
+    return;
+  }
+
+  wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to create wakeup eventfd: " + std::string(std::strerror(errno)));
+    return;
+  }
+
+  // The wakeup fd is tagged with a null pointer so Run() can tell it apart
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLET;
+  ev.data.ptr = nullptr;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev);
+
+  if (timers_.NativeHandle() >= 0) {
+    Add(timers_.NativeHandle(), EPOLLIN, [this](uint32_t) { timers_.Expire(); });
+  }
+}
+
+EventLoop::~EventLoop() {
+  for (int fd : timer_fds_) ::close(fd);
+  if (wakeup_fd_ >= 0) ::close(wakeup_fd_);
+  if (epoll_fd_ >= 0) ::close(epoll_fd_);
+}
+
+bool EventLoop::Add(int fd, uint32_t events, EventCallback callback) {
+  auto holder = std::make_unique<EventCallback>(std::move(callback));
+
+  epoll_event ev{};
+  ev.events = events | EPOLLET;
+  ev.data.ptr = holder.get();
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to add fd to epoll: " + std::string(std::strerror(errno)));
+    return false;
+  }
+
+  callbacks_[fd] = std::move(holder);
+  return true;
+}
+
+void EventLoop::Remove(int fd) {
+  auto it = callbacks_.find(fd);
+  if (it == callbacks_.end()) {
+    return;
+  }
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+
+  // The callback may be the one currently executing, destroy it later
+  retired_.push_back(std::move(it->second));
+  callbacks_.erase(it);
+}
+
+void EventLoop::Retire(std::shared_ptr<void> object) {
+  graveyard_.push_back(std::move(object));
+}
+
+bool EventLoop::RunEvery(std::chrono::milliseconds interval, std::function<void()> task) {
+  int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (fd < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to create timerfd: " + std::string(std::strerror(errno)));
+    return false;
+  }
+  timer_fds_.push_back(fd);
+
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(interval);
+  itimerspec spec{};
+  spec.it_interval.tv_sec = seconds.count();
+  spec.it_interval.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(interval - seconds).count();
+  spec.it_value = spec.it_interval;
+  if (::timerfd_settime(fd, 0, &spec, nullptr) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to arm timerfd: " + std::string(std::strerror(errno)));
+    return false;
+  }
+
+  return Add(fd, EPOLLIN, [fd, task = std::move(task)](uint32_t) {
+    uint64_t expirations;
+    while (::read(fd, &expirations, sizeof(expirations)) > 0) {}
+    task();
+  });
+}
+
+bool EventLoop::RunAfter(std::chrono::milliseconds delay, std::function<void()> task) {
+  return timers_.RunAfter(delay, std::move(task));
+}
+
+void EventLoop::Post(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(post_mutex_);
+    posted_.push_back(std::move(task));
+  }
+  Wakeup();
+}
+
+void EventLoop::Run() {
+  while (!stop_) {
+    if (!RunOnce(-1)) {
+      break;
+    }
+  }
+}
+
+bool EventLoop::RunOnce(int timeout_ms) {
+  epoll_event events[kMaxEvents];
+
+  int ready = ::epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  if (ready < 0) {
+    if (errno == EINTR) {
+      return true;
+    }
+    Logger::Instance().Log(Logger::Level::ERROR, "epoll_wait failed: " + std::string(std::strerror(errno)));
+    return false;
+  }
+
+  bool woken = false;
+  for (int i = 0; i < ready; ++i) {
+    auto* callback = static_cast<EventCallback*>(events[i].data.ptr);
+    if (callback == nullptr) {
+      woken = true;
+      continue;
+    }
+    // Removed by an earlier callback of this round: its descriptor is no longer watched
+    if (!retired_.empty() && std::any_of(retired_.begin(), retired_.end(),
+                                         [callback](const auto& retired) { return retired.get() == callback; })) {
+      continue;
+    }
+    (*callback)(events[i].events);
+  }
+
+  if (woken) {
+    RunPostedTasks();
+  }
+  retired_.clear();
+  graveyard_.clear();
+  return true;
+}
+
+void EventLoop::Stop() {
+  stop_ = true;
+  Wakeup();
+}
+
+void EventLoop::RunPostedTasks() {
+  uint64_t counter;
+  while (::read(wakeup_fd_, &counter, sizeof(counter)) > 0) {}
+
+  std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard<std::mutex> lock(post_mutex_);
+    tasks.swap(posted_);
+  }
+  for (auto& task : tasks) {
+    task();
+  }
+}
+
+void EventLoop::Wakeup() {
+  uint64_t one = 1;
+  ssize_t written = ::write(wakeup_fd_, &one, sizeof(one));
+  (void)written;
+}
+
+} // namespace revak
@@ -0,0 +1,206 @@
+/**
+ * @file HeaderScanner.cc
+ * @brief HeaderScanner class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/HeaderScanner.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REVAK_HEADER_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace revak {
+
+namespace {
+
+using Line = HeaderScanner::Line;
+using ScanFunction = size_t (*)(const char* data, size_t position, size_t size, Line& line);
+
+/** True while the colon has not been seen and the name is still valid */
+inline bool NameOpen(const Line& line) {
+  return line.colon == std::string_view::npos && line.name_valid;
+}
+
+size_t ScanScalar(const char* data, size_t position, size_t size, Line& line) {
+  for (; position < size; ++position) {
+    char c = data[position];
+    if (c == '\n') {
+      return position;
+    }
+    if (NameOpen(line)) {
+      if (c == ':') {
+        line.colon = position;
+      } else if (!IsTokenChar(c)) {
+        line.name_valid = false;
+      }
+    }
+  }
+  return std::string_view::npos;
+}
+
+#ifdef REVAK_HEADER_SCANNER_X86
+
+/**
+ * Token lookup by low nibble: bit h is set if the byte (h << 4 | low) is a
+ * token character. Bytes with the top bit set are never tokens, so eight
+ * bits cover every high nibble that can match.
+ */
+constexpr std::array<uint8_t, 16> kTokensByLowNibble = [] {
+  std::array<uint8_t, 16> table{};
+  for (unsigned c = 0; c < 128; ++c) {
+    if (detail::kTokenChars[c]) {
+      table[c & 0x0f] = static_cast<uint8_t>(table[c & 0x0f] | (1u << (c >> 4)));
+    }
+  }
+  return table;
+}();
+
+/** Bit of each high nibble in kTokensByLowNibble, none for 8 to 15 */
+constexpr std::array<uint8_t, 16> kHighNibbleBit = {1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0};
+
+/**
+ * Fold one block's match masks into the line state: only bytes before the
+ * first line feed belong to the line, only bytes before the first colon to
+ * the name.
+ */
+inline void ScanName(Line& line, size_t position, uint32_t feeds, uint32_t colons, uint32_t invalid) {
+  if (feeds != 0) {
+    uint32_t before_feed = (feeds & (0u - feeds)) - 1;
+    colons &= before_feed;
+    invalid &= before_feed;
+  }
+  if (colons != 0) {
+    invalid &= (colons & (0u - colons)) - 1;
+    line.colon = position + static_cast<size_t>(std::countr_zero(colons));
+  }
+  if (invalid != 0) {
+    line.name_valid = false;
+  }
+}
+
+__attribute__((target("sse4.2"))) size_t ScanSse42(const char* data, size_t position, size_t size, Line& line) {
+  const __m128i line_feed = _mm_set1_epi8('\n');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i by_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokensByLowNibble.data()));
+  const __m128i high_bit = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHighNibbleBit.data()));
+
+  for (; position + 16 <= size; position += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+    auto feeds = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, line_feed)));
+    if (NameOpen(line)) {
+      auto colons = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, colon)));
+      __m128i low = _mm_shuffle_epi8(by_low, _mm_and_si128(block, nibble));
+      __m128i high = _mm_shuffle_epi8(high_bit, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+      auto invalid = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high), zero)));
+      ScanName(line, position, feeds, colons, invalid);
+    }
+    if (feeds != 0) {
+      return position + static_cast<size_t>(std::countr_zero(feeds));
+    }
+  }
+  return ScanScalar(data, position, size, line);
+}
+
+__attribute__((target("avx2"))) size_t ScanAvx2(const char* data, size_t position, size_t size, Line& line) {
+  const __m256i line_feed = _mm256_set1_epi8('\n');
+  const __m256i colon = _mm256_set1_epi8(':');
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  const __m256i zero = _mm256_setzero_si256();
+  // The byte shuffle works within each 128-bit lane: both lanes get the table
+  const __m256i by_low =
+    _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokensByLowNibble.data())));
+  const __m256i high_bit =
+    _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kHighNibbleBit.data())));
+
+  for (; position + 32 <= size; position += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+    auto feeds = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, line_feed)));
+    if (NameOpen(line)) {
+      auto colons = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, colon)));
+      __m256i low = _mm256_shuffle_epi8(by_low, _mm256_and_si256(block, nibble));
+      __m256i high = _mm256_shuffle_epi8(high_bit, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+      auto invalid = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero)));
+      ScanName(line, position, feeds, colons, invalid);
+    }
+    if (feeds != 0) {
+      return position + static_cast<size_t>(std::countr_zero(feeds));
+    }
+  }
+  // Clear the upper halves before legacy SSE code runs, which stalls otherwise
+  _mm256_zeroupper();
+  return ScanSse42(data, position, size, line);
+}
+
+#endif // REVAK_HEADER_SCANNER_X86
+
+HeaderScanner::Implementation Detect() {
+#ifdef REVAK_HEADER_SCANNER_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return HeaderScanner::Implementation::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return HeaderScanner::Implementation::SSE42;
+  }
+#endif
+  return HeaderScanner::Implementation::SCALAR;
+}
+
+ScanFunction FunctionFor(HeaderScanner::Implementation implementation) {
+  switch (implementation) {
+#ifdef REVAK_HEADER_SCANNER_X86
+    case HeaderScanner::Implementation::AVX2: return ScanAvx2;
+    case HeaderScanner::Implementation::SSE42: return ScanSse42;
+#endif
+    default: return ScanScalar;
+  }
+}
+
+/** Widest supported implementation, detected once */
+const HeaderScanner::Implementation best_implementation = Detect();
+
+/** Implementation in use and its function */
+HeaderScanner::Implementation active_implementation = best_implementation;
+ScanFunction active_scan = FunctionFor(best_implementation);
+
+} // namespace
+
+size_t HeaderScanner::FindLineEnd(std::string_view data, size_t position) {
+  return active_scan(data.data(), position, data.size(), line_);
+}
+
+bool HeaderScanner::Use(Implementation implementation) {
+  if (implementation > best_implementation) {
+    return false;
+  }
+  active_implementation = implementation;
+  active_scan = FunctionFor(implementation);
+  return true;
+}
+
+HeaderScanner::Implementation HeaderScanner::Best() {
+  return best_implementation;
+}
+
+HeaderScanner::Implementation HeaderScanner::Active() {
+  return active_implementation;
+}
+
+std::string_view HeaderScanner::Name(Implementation implementation) {
+  switch (implementation) {
+    case Implementation::AVX2: return "avx2";
+    case Implementation::SSE42: return "sse4.2";
+    default: return "scalar";
+  }
+}
+
+} // namespace revak
@@ -0,0 +1,379 @@
+/**
+ * @file IoUring.cc
+ * @brief IoUring class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/IoUring.h"
+#include "revak/Logger.h"
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace revak {
+
+namespace {
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+/** Multishot recv with provided-buffer rings arrived in Linux 6.0 */
+bool KernelAtLeast(int major, int minor) {
+  utsname name{};
+  if (::uname(&name) != 0) {
+    return false;
+  }
+  int kernel_major = 0;
+  int kernel_minor = 0;
+  if (std::sscanf(name.release, "%d.%d", &kernel_major, &kernel_minor) != 2) {
+    return false;
+  }
+  return kernel_major > major || (kernel_major == major && kernel_minor >= minor);
+}
+
+} // namespace
+
+bool IoUring::IsSupported() {
+  static const bool supported = [] {
+    if (!KernelAtLeast(6, 0)) {
+      return false;
+    }
+    // Seccomp filters and io_uring_disabled report themselves here
+    IoUring ring(4);
+    return ring.IsValid() && ring.SetupProvidedBuffers(0, 1, 64);
+  }();
+  return supported;
+}
+
+IoUring::IoUring(unsigned entries) {
+  // Completions of multishot operations outnumber submissions, give them room
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+  params.cq_entries = entries * 4;
+  int fd = IoUringSetup(entries, &params);
+  if (fd < 0 && errno == EINVAL) {
+    // Older kernels reject the task-run hints
+    params = {};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+    fd = IoUringSetup(entries, &params);
+  }
+  if (fd < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to create io_uring: " + std::string(std::strerror(errno)));
+    return;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+  } else if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+    }
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+
+  if (sq_ring_ == nullptr || cq_ring_ == nullptr || sqes_ == nullptr) {
+    // The destructor unmaps whatever was mapped
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to map io_uring queues: " + std::string(std::strerror(errno)));
+    ::close(fd);
+    return;
+  }
+  ring_fd_ = fd;
+
+  auto* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sqe_tail_ = *sq_tail_;
+
+  // Entry i always sits in slot i, so the indirection array is filled once
+  auto* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  for (unsigned i = 0; i < sq_entries_; ++i) {
+    array[i] = i;
+  }
+
+  auto* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+  if (buffer_ring_ != nullptr) ::munmap(buffer_ring_, buffer_ring_size_);
+  if (sqes_ != nullptr) ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) ::munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ >= 0) ::close(ring_fd_);
+}
+
+bool IoUring::SetupProvidedBuffers(uint16_t group, uint16_t count, uint32_t size) {
+  buffers_ = std::make_unique<char[]>(static_cast<size_t>(count) * size);
+  buffer_size_ = size;
+  buffer_group_ = group;
+
+  if (RegisterBufferRing(count)) {
+    return true;
+  }
+  if (!ProvideBuffers(0, count)) {
+    return false;
+  }
+
+  // Check the classic way works too before the caller relies on it
+  int pair[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) != 0) {
+    return false;
+  }
+  bool works = ::write(pair[1], "x", 1) == 1 && TestReceive(pair[0]);
+  ::close(pair[0]);
+  ::close(pair[1]);
+  if (!works) {
+    Logger::Instance().Log(Logger::Level::ERROR, "io_uring provided buffers are not usable");
+  }
+  return works;
+}
+
+bool IoUring::RegisterBufferRing(uint16_t count) {
+  // The ring must be page aligned, an anonymous mapping is
+  size_t ring_size = count * sizeof(io_uring_buf);
+  void* memory = ::mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  io_uring_buf_reg registration{};
+  registration.ring_addr = reinterpret_cast<uint64_t>(memory);
+  registration.ring_entries = count;
+  registration.bgid = buffer_group_;
+  if (IoUringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+    ::munmap(memory, ring_size);
+    return false;
+  }
+  buffer_ring_ = static_cast<io_uring_buf_ring*>(memory);
+  buffer_ring_size_ = ring_size;
+  buffer_mask_ = static_cast<uint16_t>(count - 1);
+  buffer_tail_ = 0;
+  for (uint16_t id = 0; id < count; ++id) {
+    RecycleBuffer(id);
+  }
+
+  int pair[2];
+  bool works = false;
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0) {
+    works = ::write(pair[1], "x", 1) == 1 && TestReceive(pair[0]);
+    ::close(pair[0]);
+    ::close(pair[1]);
+  }
+  if (!works) {
+    io_uring_buf_reg unregistration{};
+    unregistration.bgid = buffer_group_;
+    IoUringRegister(ring_fd_, IORING_UNREGISTER_PBUF_RING, &unregistration, 1);
+    ::munmap(buffer_ring_, buffer_ring_size_);
+    buffer_ring_ = nullptr;
+  }
+  return works;
+}
+
+bool IoUring::TestReceive(int fd) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buffer_group_;
+  sqe->user_data = kTestUserData;
+
+  // Internal completions are skipped by ForEachCompletion(), so wait for the test one here
+  while (Submit(1)) {
+    unsigned head = *cq_head_;
+    unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+    bool done = false;
+    bool received = false;
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      if (cqe.user_data == kTestUserData) {
+        done = true;
+        received = cqe.res == 1;
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+          RecycleBuffer(BufferId(cqe));
+        }
+      }
+    }
+    std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+    if (done) {
+      return received;
+    }
+  }
+  return false;
+}
+
+void IoUring::RecycleBuffer(uint16_t id) {
+  if (buffer_ring_ == nullptr) {
+    ProvideBuffers(id, 1);
+    return;
+  }
+  io_uring_buf& slot = buffer_ring_->bufs[buffer_tail_ & buffer_mask_];
+  slot.addr = reinterpret_cast<uint64_t>(buffers_.get() + static_cast<size_t>(id) * buffer_size_);
+  slot.len = buffer_size_;
+  slot.bid = id;
+  std::atomic_ref<uint16_t>(buffer_ring_->tail).store(++buffer_tail_, std::memory_order_release);
+}
+
+bool IoUring::ProvideBuffers(uint16_t id, uint16_t count) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    Logger::Instance().Log(Logger::Level::WARNING, "io_uring submission queue full, receive buffer lost");
+    return false;
+  }
+  sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+  sqe->fd = count;
+  sqe->addr = reinterpret_cast<uint64_t>(buffers_.get() + static_cast<size_t>(id) * buffer_size_);
+  sqe->len = buffer_size_;
+  sqe->off = id;
+  sqe->buf_group = buffer_group_;
+  sqe->user_data = kInternalUserData;
+  return true;
+}
+
+io_uring_sqe* IoUring::NextSqe() {
+  unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+  if (sqe_tail_ - head >= sq_entries_) {
+    Submit(0);
+    head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+    if (sqe_tail_ - head >= sq_entries_) {
+      return nullptr;
+    }
+  }
+  io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+  ++sqe_tail_;
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+bool IoUring::PrepareAcceptMultishot(int fd, uint64_t user_data) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = fd;
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+  sqe->user_data = user_data;
+  return true;
+}
+
+bool IoUring::PrepareRecvMultishot(int fd, uint16_t group, uint64_t user_data) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = group;
+  sqe->user_data = user_data;
+  return true;
+}
+
+bool IoUring::PrepareSendmsg(int fd, const msghdr* message, unsigned flags, bool link, uint64_t user_data) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(message);
+  sqe->len = 1;
+  sqe->msg_flags = flags;
+  sqe->flags = link ? IOSQE_IO_LINK : 0;
+  sqe->user_data = user_data;
+  return true;
+}
+
+bool IoUring::PreparePoll(int fd, uint32_t events, bool multishot, uint64_t user_data) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = user_data;
+  return true;
+}
+
+bool IoUring::PrepareCancel(uint64_t target, uint64_t user_data) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = target;
+  sqe->user_data = user_data;
+  return true;
+}
+
+unsigned IoUring::SpaceLeft() const {
+  return sq_entries_ - (sqe_tail_ - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire));
+}
+
+bool IoUring::Submit(unsigned wait_for) {
+  std::atomic_ref<unsigned>(*sq_tail_).store(sqe_tail_, std::memory_order_release);
+
+  unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+  while (true) {
+    // Everything published that the kernel has not consumed yet
+    unsigned to_submit = sqe_tail_ - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+    if (IoUringEnter(ring_fd_, to_submit, wait_for, flags) >= 0) {
+      return true;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EBUSY) {
+      return true; // Completion queue backed up: reap first, the entries stay queued
+    }
+    Logger::Instance().Log(Logger::Level::ERROR, "io_uring_enter failed: " + std::string(std::strerror(errno)));
+    return false;
+  }
+}
+
+} // namespace revak
@@ -1,19 +1,111 @@
 /**
  * @file Logger.cc
  * @brief Implementation of the Logger class for asynchronous logging.
- * 
+ *
  * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
  * Licensed under the MIT License. Part of the Revak project.
  */
 
 #include "revak/Logger.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
-#include <iostream>
+#include <cstring>
 #include <format>
+#include <unistd.h>
 
 namespace revak {
 
+namespace {
+
+/** Size of each thread's ring buffer */
+constexpr size_t kRingCapacity = 64 * 1024;
+
+/** Longer messages are truncated so one record never fills a ring */
+constexpr size_t kMaxMessageLength = kRingCapacity / 8;
+
+/** Batch size that triggers a write before the rings are fully drained */
+constexpr size_t kBatchFlushSize = 64 * 1024;
+
+/** How long the log thread sleeps when there was nothing to drain */
+constexpr auto kIdleInterval = std::chrono::milliseconds(10);
+
+/** Fixed-size part of a record, followed by the message bytes */
+struct RecordHeader {
+  int64_t timestamp_ms;
+  uint32_t length;
+  Logger::Level level;
+};
+
+std::string_view LevelName(Logger::Level level) {
+  switch (level) {
+    case Logger::Level::DEBUG: return "DBG ";
+    case Logger::Level::INFO: return "INFO";
+    case Logger::Level::WARNING: return "WARN";
+    case Logger::Level::ERROR: return "ERR ";
+  }
+  return "????";
+}
+
+/** Append "[Timestamp|Level] Message\n" */
+void FormatLine(std::string& out, int64_t timestamp_ms, Logger::Level level, std::string_view message) {
+  std::chrono::sys_time<std::chrono::milliseconds> time{std::chrono::milliseconds(timestamp_ms)};
+  std::format_to(std::back_inserter(out), "[{:%Y-%m-%d %H:%M:%S}|{}] {}\n", time, LevelName(level), message);
+}
+
+} // namespace
+
+/**
+ * Single-producer single-consumer byte ring. The owning thread appends
+ * records at tail, the log thread consumes them from head; positions only
+ * grow and are wrapped when indexing.
+ */
+struct Logger::Ring {
+  /** Copy bytes in at a position, wrapping around the end */
+  void CopyIn(uint64_t position, const void* src, size_t length) {
+    size_t offset = static_cast<size_t>(position % kRingCapacity);
+    size_t first = std::min(length, kRingCapacity - offset);
+    std::memcpy(data + offset, src, first);
+    std::memcpy(data, static_cast<const char*>(src) + first, length - first);
+  }
+
+  /** Copy bytes out from a position, wrapping around the end */
+  void CopyOut(uint64_t position, void* dst, size_t length) const {
+    size_t offset = static_cast<size_t>(position % kRingCapacity);
+    size_t first = std::min(length, kRingCapacity - offset);
+    std::memcpy(dst, data + offset, first);
+    std::memcpy(static_cast<char*>(dst) + first, data, length - first);
+  }
+
+  /** Next byte the log thread reads */
+  alignas(64) std::atomic<uint64_t> head{0};
+
+  /** Next byte the owning thread writes */
+  alignas(64) std::atomic<uint64_t> tail{0};
+
+  /** Messages dropped because the ring was full */
+  std::atomic<uint64_t> dropped{0};
+
+  /** Drops already reported (log thread only) */
+  uint64_t reported_drops{0};
+
+  /** Set when the owning thread has exited */
+  std::atomic<bool> orphaned{false};
+
+  char data[kRingCapacity];
+};
+
+struct Logger::ThreadRing {
+  ~ThreadRing() {
+    if (ring) {
+      ring->orphaned.store(true, std::memory_order_release);
+    }
+  }
+
+  std::shared_ptr<Ring> ring;
+};
+
 Logger& Logger::Instance() {
   static Logger instance;
   return instance;
@@ -21,33 +113,29 @@ Logger& Logger::Instance() {
 
 Logger::Logger() {
   log_thread_ = std::thread([this]() {
-    while(true) {
-      {
-        // Lock the queue mutex
-        std::unique_lock<std::mutex> lock(this->queue_mutex_);
-
-        // Wait until there is a log message or stop signal
-        this->log_condition_.wait(lock, [this] {
-          return this->stop_logging_.load() || !this->log_queue_.empty();
-        });
-
-        // If stopping and no messages left, exit the loop
-        if (this->stop_logging_.load() && this->log_queue_.empty()) {
-          break;
-        }
+    std::string batch;
+    while (true) {
+      bool stopping = stop_logging_.load(std::memory_order_acquire);
+      bool drained = Drain(batch);
+      WriteBatch(batch);
 
-        std::string message = std::move(this->log_queue_.front());
-        this->log_queue_.pop();
-
-        std::cout << message << std::endl;
-      } // Scope for lock ends here
+      // If stopping and no messages left, exit the loop
+      if (stopping && !drained) {
+        break;
+      }
+      if (!drained) {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        log_condition_.wait_for(lock, kIdleInterval, [this] {
+          return stop_logging_.load(std::memory_order_acquire);
+        });
+      }
     }
   });
 }
 
 Logger::~Logger() {
   {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
     stop_logging_ = true;
   }
   log_condition_.notify_all();
@@ -57,26 +145,115 @@ Logger::~Logger() {
   }
 }
 
-void Logger::Log(Level level, const std::string& message) {
-  // [Timestamp] [Level] [Message]
-  auto now = std::chrono::system_clock::now();
-  auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  std::string timestamp = std::format("{:%Y-%m-%d %H:%M:%S}", now_ms);
+void Logger::Log(Level level, std::string_view message) {
+  if (!IsEnabled(level)) {
+    return;
+  }
 
-  std::string level_str;
-  switch (level) {
-    case Level::INFO: level_str = "INFO"; break;
-    case Level::WARNING: level_str = "WARN"; break;
-    case Level::ERROR: level_str = "ERR "; break;
+  // [Timestamp] [Level] [Message], formatted later by the log thread
+  RecordHeader header{};
+  header.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  header.length = static_cast<uint32_t>(std::min(message.size(), kMaxMessageLength));
+  header.level = level;
+
+  Ring& ring = LocalRing();
+  const size_t record_size = sizeof(header) + header.length;
+  uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+  uint64_t head = ring.head.load(std::memory_order_acquire);
+
+  if (kRingCapacity - (tail - head) < record_size) {
+    // Never block the caller on log output
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
   }
 
-  std::string log_entry = std::format("[{}|{}] {}", timestamp, level_str, message);
+  ring.CopyIn(tail, &header, sizeof(header));
+  ring.CopyIn(tail + sizeof(header), message.data(), header.length);
+  ring.tail.store(tail + record_size, std::memory_order_release);
+}
+
+uint64_t Logger::DroppedMessages() const {
+  // Under the lock Drain() moves a dead thread's count with, so it is counted exactly once
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  uint64_t dropped = retired_drops_.load(std::memory_order_relaxed);
+  for (const auto& ring : rings_) {
+    dropped += ring->dropped.load(std::memory_order_relaxed);
+  }
+  return dropped;
+}
+
+Logger::Ring& Logger::LocalRing() {
+  thread_local ThreadRing local;
+  if (!local.ring) {
+    local.ring = std::make_shared<Ring>();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(local.ring);
+  }
+  return *local.ring;
+}
 
+bool Logger::Drain(std::string& batch) {
+  std::vector<std::shared_ptr<Ring>> rings;
   {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    log_queue_.push(log_entry);
-    log_condition_.notify_one();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings = rings_;
+  }
+
+  bool drained = false;
+  std::string message;
+  for (const auto& ring : rings) {
+    // Read orphaned before tail, so a ring seen orphaned is also seen complete
+    bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+
+    while (head < tail) {
+      RecordHeader header;
+      ring->CopyOut(head, &header, sizeof(header));
+      message.resize(header.length);
+      ring->CopyOut(head + sizeof(header), message.data(), header.length);
+      head += sizeof(header) + header.length;
+
+      FormatLine(batch, header.timestamp_ms, header.level, message);
+      if (batch.size() >= kBatchFlushSize) {
+        WriteBatch(batch);
+      }
+      drained = true;
+    }
+    ring->head.store(head, std::memory_order_release);
+
+    uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+    if (dropped != ring->reported_drops) {
+      auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+      FormatLine(batch, now, Level::WARNING,
+                 std::format("Dropped {} log messages, ring buffer full", dropped - ring->reported_drops));
+      ring->reported_drops = dropped;
+    }
+
+    if (orphaned) {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      retired_drops_.fetch_add(dropped, std::memory_order_relaxed);
+      rings_.erase(std::find(rings_.begin(), rings_.end(), ring));
+    }
+  }
+  return drained;
+}
+
+void Logger::WriteBatch(std::string& batch) {
+  size_t written = 0;
+  while (written < batch.size()) {
+    ssize_t n = ::write(STDOUT_FILENO, batch.data() + written, batch.size() - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break; // Nowhere to report a failing log sink
+    }
+    written += static_cast<size_t>(n);
   }
+  batch.clear();
 }
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
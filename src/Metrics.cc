@@ -0,0 +1,273 @@
+/**
+ * @file Metrics.cc
+ * @brief Metrics class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include <revak/Metrics.h>
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string_view>
+
+namespace revak {
+
+namespace {
+
+/** Source of Metrics instance ids, 0 marks an empty thread-local cache */
+std::atomic<uint64_t> next_instance_id{1};
+
+/** Quantiles reported for every latency summary */
+constexpr double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+/** Single-writer increment: a relaxed load and store, no read-modify-write */
+inline void Bump(std::atomic<uint64_t>& counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+double Seconds(uint64_t nanoseconds) {
+  return static_cast<double>(nanoseconds) / 1e9;
+}
+
+/** Quote a label value: backslash, double quote and line feed are escaped */
+std::string EscapeLabel(std::string_view value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\': escaped += "\\\\"; break;
+      case '"': escaped += "\\\""; break;
+      case '\n': escaped += "\\n"; break;
+      default: escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/** Label set in braces, nothing if there are no labels */
+std::string Braces(const std::string& labels) {
+  return labels.empty() ? std::string() : "{" + labels + "}";
+}
+
+/** Counts of one route added over every shard */
+struct RouteTotals {
+  /** method="...",route="..." */
+  std::string labels;
+
+  std::array<uint64_t, 5> status_classes{};
+  Histogram::Snapshot latency;
+};
+
+/** Add the totals of one route to another's */
+void Merge(const RouteTotals& from, RouteTotals& into) {
+  for (size_t i = 0; i < into.status_classes.size(); ++i) {
+    into.status_classes[i] += from.status_classes[i];
+  }
+  for (size_t i = 0; i < into.latency.counts.size(); ++i) {
+    into.latency.counts[i] += from.latency.counts[i];
+  }
+  into.latency.count += from.latency.count;
+  into.latency.sum += from.latency.sum;
+}
+
+/**
+ * Append a histogram with one bucket per power of two; the finer buckets
+ * only serve the quantiles of the matching summary
+ */
+void AppendHistogram(std::string& out, std::string_view name, const std::string& labels, const Histogram::Snapshot& snapshot) {
+  std::string_view separator = labels.empty() ? "" : ",";
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < Histogram::kBuckets; ++i) {
+    cumulative += snapshot.counts[i];
+    if (i % Histogram::kSubBuckets == 0) {
+      std::format_to(std::back_inserter(out), "{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator,
+                     Seconds(Histogram::UpperBound(i)), cumulative);
+    }
+  }
+  std::format_to(std::back_inserter(out), "{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, labels, separator, snapshot.count);
+  std::format_to(std::back_inserter(out), "{}_sum{} {}\n", name, Braces(labels), Seconds(snapshot.sum));
+  std::format_to(std::back_inserter(out), "{}_count{} {}\n", name, Braces(labels), snapshot.count);
+}
+
+/** Append a summary with the quantiles estimated from the full-resolution histogram */
+void AppendSummary(std::string& out, std::string_view name, const std::string& labels, const Histogram::Snapshot& snapshot) {
+  std::string_view separator = labels.empty() ? "" : ",";
+  for (double quantile : kQuantiles) {
+    std::format_to(std::back_inserter(out), "{}{{{}{}quantile=\"{}\"}} {}\n", name, labels, separator, quantile,
+                   Seconds(snapshot.Quantile(quantile)));
+  }
+  std::format_to(std::back_inserter(out), "{}_sum{} {}\n", name, Braces(labels), Seconds(snapshot.sum));
+  std::format_to(std::back_inserter(out), "{}_count{} {}\n", name, Braces(labels), snapshot.count);
+}
+
+void AppendHeader(std::string& out, std::string_view name, std::string_view type, std::string_view help) {
+  std::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+} // namespace
+
+Metrics::Shard::~Shard() {
+  for (std::atomic<RouteChunk*>& chunk : chunks) {
+    delete chunk.load(std::memory_order_relaxed);
+  }
+}
+
+Metrics::Metrics() : instance_id_(next_instance_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+Metrics::~Metrics() = default;
+
+void Metrics::RecordRequest(size_t route_id, int status, uint64_t duration_ns) {
+  Shard& shard = LocalShard();
+  RouteStats& route = route_id < kMaxRoutes ? LocalRoute(shard, route_id) : shard.unmatched;
+
+  int status_class = status / 100 - 1;
+  if (status_class >= 0 && status_class < 5) {
+    Bump(route.status_classes[static_cast<size_t>(status_class)]);
+  }
+  route.latency.Record(duration_ns);
+}
+
+void Metrics::ConnectionOpened() {
+  Bump(LocalShard().connections_opened);
+}
+
+void Metrics::ConnectionClosed() {
+  Bump(LocalShard().connections_closed);
+}
+
+void Metrics::RequestShed() {
+  Bump(LocalShard().requests_shed);
+}
+
+Metrics::Shard& Metrics::LocalShard() {
+  // One cached shard per thread; a thread recording into a second instance looks it up again
+  thread_local uint64_t cached_instance = 0;
+  thread_local Shard* cached_shard = nullptr;
+  if (cached_instance == instance_id_) {
+    return *cached_shard;
+  }
+
+  std::thread::id self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(shards_mutex_);
+  auto it = std::find_if(shards_.begin(), shards_.end(), [self](const auto& entry) { return entry.first == self; });
+  if (it == shards_.end()) {
+    shards_.emplace_back(self, std::make_unique<Shard>());
+    it = std::prev(shards_.end());
+  }
+  cached_instance = instance_id_;
+  cached_shard = it->second.get();
+  return *cached_shard;
+}
+
+Metrics::RouteStats& Metrics::LocalRoute(Shard& shard, size_t route_id) {
+  std::atomic<RouteChunk*>& slot = shard.chunks[route_id / kRoutesPerChunk];
+  RouteChunk* chunk = slot.load(std::memory_order_relaxed);
+  if (chunk == nullptr) {
+    chunk = new RouteChunk();
+    slot.store(chunk, std::memory_order_release);
+  }
+  return chunk->routes[route_id % kRoutesPerChunk];
+}
+
+std::string Metrics::Render(const Router& router, const ThreadPool::Stats& pool) const {
+  size_t route_count = std::min(router.RouteCount(), kMaxRoutes);
+  std::vector<RouteTotals> routes(route_count);
+  RouteTotals unmatched;
+  uint64_t opened = 0;
+  uint64_t closed = 0;
+  uint64_t shed = 0;
+
+  auto add = [](const RouteStats& stats, RouteTotals& totals) {
+    for (size_t i = 0; i < totals.status_classes.size(); ++i) {
+      totals.status_classes[i] += stats.status_classes[i].load(std::memory_order_relaxed);
+    }
+    stats.latency.AddTo(totals.latency);
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(shards_mutex_);
+    for (const auto& [thread, shard] : shards_) {
+      for (size_t c = 0; c * kRoutesPerChunk < route_count; ++c) {
+        const RouteChunk* chunk = shard->chunks[c].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+          continue;
+        }
+        for (size_t i = 0; i < kRoutesPerChunk && c * kRoutesPerChunk + i < route_count; ++i) {
+          add(chunk->routes[i], routes[c * kRoutesPerChunk + i]);
+        }
+      }
+      add(shard->unmatched, unmatched);
+      opened += shard->connections_opened.load(std::memory_order_relaxed);
+      closed += shard->connections_closed.load(std::memory_order_relaxed);
+      shed += shard->requests_shed.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Routes never hit are left out; requests no route matched have empty labels
+  std::vector<RouteTotals*> reported;
+  for (size_t id = 0; id < route_count; ++id) {
+    if (routes[id].latency.count > 0) {
+      std::shared_ptr<const Route> route = router.GetRoute(id);
+      routes[id].labels = std::format("method=\"{}\",route=\"{}\"", EscapeLabel(route->method), EscapeLabel(route->path));
+
+      // A route removed and added again has a new id but the same series
+      auto same = std::find_if(reported.begin(), reported.end(), [&routes, id](const RouteTotals* earlier) {
+        return earlier->labels == routes[id].labels;
+      });
+      if (same == reported.end()) {
+        reported.push_back(&routes[id]);
+      } else {
+        Merge(routes[id], **same);
+      }
+    }
+  }
+  if (unmatched.latency.count > 0) {
+    unmatched.labels = "method=\"\",route=\"\"";
+    reported.push_back(&unmatched);
+  }
+
+  std::string out;
+  AppendHeader(out, "revak_http_requests_total", "counter", "Requests handled, by route and status class.");
+  for (const RouteTotals* route : reported) {
+    for (size_t i = 0; i < route->status_classes.size(); ++i) {
+      if (route->status_classes[i] > 0) {
+        std::format_to(std::back_inserter(out), "revak_http_requests_total{{{},code=\"{}xx\"}} {}\n", route->labels, i + 1,
+                       route->status_classes[i]);
+      }
+    }
+  }
+
+  AppendHeader(out, "revak_http_request_duration_seconds", "histogram", "Time from dispatch to the queued response.");
+  for (const RouteTotals* route : reported) {
+    AppendHistogram(out, "revak_http_request_duration_seconds", route->labels, route->latency);
+  }
+
+  AppendHeader(out, "revak_http_request_latency_seconds", "summary", "Quantiles of the request duration, within 12.5%.");
+  for (const RouteTotals* route : reported) {
+    AppendSummary(out, "revak_http_request_latency_seconds", route->labels, route->latency);
+  }
+
+  AppendHeader(out, "revak_connections_active", "gauge", "Open client connections.");
+  std::format_to(std::back_inserter(out), "revak_connections_active {}\n", opened >= closed ? opened - closed : 0);
+  AppendHeader(out, "revak_connections_accepted_total", "counter", "Client connections accepted.");
+  std::format_to(std::back_inserter(out), "revak_connections_accepted_total {}\n", opened);
+  AppendHeader(out, "revak_requests_shed_total", "counter", "Requests answered 503 because the server was overloaded.");
+  std::format_to(std::back_inserter(out), "revak_requests_shed_total {}\n", shed);
+
+  AppendHeader(out, "revak_thread_pool_threads", "gauge", "Worker threads of the pool.");
+  std::format_to(std::back_inserter(out), "revak_thread_pool_threads {}\n", pool.threads);
+  AppendHeader(out, "revak_thread_pool_queued_tasks", "gauge", "Tasks waiting for a worker.");
+  std::format_to(std::back_inserter(out), "revak_thread_pool_queued_tasks {}\n", pool.queued);
+  AppendHeader(out, "revak_thread_pool_tasks_total", "counter", "Tasks run by the pool.");
+  std::format_to(std::back_inserter(out), "revak_thread_pool_tasks_total {}\n", pool.executed);
+  AppendHeader(out, "revak_thread_pool_wait_seconds", "histogram", "Time tasks waited for a worker.");
+  AppendHistogram(out, "revak_thread_pool_wait_seconds", "", pool.wait);
+  AppendHeader(out, "revak_thread_pool_wait_latency_seconds", "summary", "Quantiles of the task wait, within 12.5%.");
+  AppendSummary(out, "revak_thread_pool_wait_latency_seconds", "", pool.wait);
+  return out;
+}
+
+} // namespace revak
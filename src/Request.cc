@@ -7,55 +7,95 @@
  */
 
 #include "revak/Request.h"
+#include "revak/RequestParser.h"
 
 #include <string_view>
-#include <algorithm>
 
 namespace revak {
 
+using detail::EqualsIgnoreCase;
+
 Request::Request(const std::string_view& request) {
-  const int kHeaderEndLength = 4, kLineEndLength = 2;
-
-  // Parse HTTP 1.1 request
-  auto header_end = request.find("\r\n\r\n");
-  
-  // Header part
-  std::string_view header_part = request.substr(0, header_end);
-  body_ = std::string(request.substr(header_end + kHeaderEndLength));
-
-  size_t line_start = 0;
-  size_t line_end = header_part.find("\r\n");
-
-  // Request Line Parse (GET /index.html HTTP/1.1)
-  if (line_end != std::string_view::npos) {
-    std::string_view first_line = header_part.substr(0, line_end);
-
-    // Method
-    size_t method_end = first_line.find(' ');
-    method_ = first_line.substr(0, method_end);
-
-    // Path
-    size_t path_end = first_line.find(' ', method_end + 1);
-    path_ = first_line.substr(method_end + 1, path_end - (method_end + 1));
-    
-    // Move line_start past the request line before parsing headers
-    line_start = line_end + kLineEndLength;
-  }
-
-  // Parse Headers
-  while((line_end = header_part.find("\r\n", line_start)) != std::string_view::npos) {
-    std::string_view line = header_part.substr(line_start, line_end - line_start);
-    
-    auto colon_pos = line.find(":");
-    if (colon_pos != std::string_view::npos) {
-      std::string_view key = line.substr(0, colon_pos);
-      std::string_view val = line.substr(colon_pos + 1);
-
-      if (!val.empty() && val[0] == ' ') val.remove_prefix(1);
-
-      headers_.emplace(key, val);
+  RequestParser parser;
+  if (parser.Parse(request) == RequestParser::Result::COMPLETE) {
+    parser.Fill(request, *this);
+  }
+}
+
+std::string_view Request::Header(std::string_view name) const {
+  if (HttpHeader header = ParseHeader(name); header != HttpHeader::OTHER) {
+    return Header(header);
+  }
+  for (const RequestHeader& header : Headers()) {
+    if (EqualsIgnoreCase(header.name, name)) {
+      return header.value;
+    }
+  }
+  return {};
+}
+
+std::string_view Request::Param(std::string_view name) const {
+  for (const RouteParam& param : Params()) {
+    if (param.name == name) {
+      return param.value;
+    }
+  }
+  return {};
+}
+
+std::span<const RequestHeader> Request::Headers() const {
+  if (header_count_ <= kInlineHeaders) {
+    return {inline_headers_.data(), header_count_};
+  }
+  return spilled_headers_;
+}
+
+void Request::AddHeader(std::string_view name, std::string_view value, HttpHeader header) {
+  if (header != HttpHeader::OTHER && header_slots_[static_cast<size_t>(header)] == kNoHeader) {
+    header_slots_[static_cast<size_t>(header)] = static_cast<uint32_t>(header_count_);
+  }
+  if (header_count_ < kInlineHeaders) {
+    inline_headers_[header_count_++] = {name, value};
+    return;
+  }
+  // Rare: move everything to the heap once the inline slots run out
+  if (header_count_ == kInlineHeaders) {
+    spilled_headers_.assign(inline_headers_.begin(), inline_headers_.end());
+  }
+  spilled_headers_.push_back({name, value});
+  ++header_count_;
+}
+
+void Request::ClearHeaders() {
+  header_count_ = 0;
+  spilled_headers_.clear();
+  header_slots_.fill(kNoHeader);
+}
+
+bool Request::KeepAlive() const {
+  std::string_view connection = Header(HttpHeader::CONNECTION);
+  if (EqualsIgnoreCase(connection, "close")) return false;
+  if (EqualsIgnoreCase(connection, "keep-alive")) return true;
+  return version_ != "HTTP/1.0";
+}
+
+bool Request::MatchesEtag(std::string_view etag) const {
+  std::string_view list = Header(HttpHeader::IF_NONE_MATCH);
+  while (!list.empty()) {
+    size_t comma = list.find(',');
+    std::string_view tag = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+    while (!tag.empty() && (tag.front() == ' ' || tag.front() == '\t')) tag.remove_prefix(1);
+    while (!tag.empty() && (tag.back() == ' ' || tag.back() == '\t')) tag.remove_suffix(1);
+    if (tag.starts_with("W/")) {
+      tag.remove_prefix(2);
+    }
+    if (tag == "*" || tag == etag) {
+      return true;
     }
-    line_start = line_end + kLineEndLength;
   }
+  return false;
 }
-}
\ No newline at end of file
+
+} // namespace revak
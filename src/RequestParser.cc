@@ -0,0 +1,180 @@
+/**
+ * @file RequestParser.cc
+ * @brief RequestParser class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/RequestParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace revak {
+
+RequestParser::Result RequestParser::Parse(std::string_view data) {
+  // Request line and headers: handle one complete line at a time, each
+  // scanned once for its line feed, colon and name characters together
+  while (state_ == State::REQUEST_LINE || state_ == State::HEADERS) {
+    size_t line_feed = scanner_.FindLineEnd(data, scan_position_);
+    if (line_feed == std::string_view::npos) {
+      // Resume the search where this one stopped
+      scan_position_ = data.size();
+      if (data.size() > limits_.max_header_size) {
+        return Fail(431);
+      }
+      return Result::NEED_MORE;
+    }
+    if (line_feed >= limits_.max_header_size) {
+      return Fail(431);
+    }
+
+    // Accept both CRLF and a bare LF as line ending
+    size_t line_end = line_feed;
+    if (line_end > line_start_ && data[line_end - 1] == '\r') {
+      --line_end;
+    }
+    size_t offset = line_start_;
+    std::string_view line = data.substr(offset, line_end - offset);
+    line_start_ = scan_position_ = line_feed + 1;
+    size_t colon = scanner_.Colon();
+    bool name_valid = scanner_.NameValid();
+    scanner_.NextLine();
+
+    if (state_ == State::REQUEST_LINE) {
+      // Empty lines before the request line are ignored (RFC 9112 section 2.2)
+      if (line.empty()) continue;
+      if (!ParseRequestLine(line, offset)) return Fail(400);
+      state_ = State::HEADERS;
+      continue;
+    }
+
+    if (line.empty()) {
+      body_start_ = line_start_;
+      if (content_length_ > limits_.max_body_size) {
+        return Fail(413);
+      }
+      state_ = content_length_ > 0 ? State::BODY : State::COMPLETE;
+      break;
+    }
+    // No whitespace is allowed between the name and the colon, and
+    // obsolete line folding (a line starting with whitespace) is rejected
+    if (colon == std::string_view::npos || !name_valid || !ParseHeaderLine(line, offset, colon - offset)) {
+      return state_ == State::ERROR ? Result::ERROR : Fail(400);
+    }
+  }
+
+  if (state_ == State::BODY && data.size() - body_start_ >= content_length_) {
+    state_ = State::COMPLETE;
+  }
+
+  switch (state_) {
+    case State::COMPLETE: return Result::COMPLETE;
+    case State::ERROR: return Result::ERROR;
+    default: return Result::NEED_MORE;
+  }
+}
+
+bool RequestParser::ParseRequestLine(std::string_view line, size_t offset) {
+  size_t method_end = line.find(' ');
+  if (method_end == std::string_view::npos || method_end == 0) {
+    return false;
+  }
+  size_t path_end = line.find(' ', method_end + 1);
+  if (path_end == std::string_view::npos || path_end == method_end + 1) {
+    return false;
+  }
+
+  std::string_view method = line.substr(0, method_end);
+  std::string_view version = line.substr(path_end + 1);
+  if (!std::all_of(method.begin(), method.end(), IsTokenChar)) {
+    return false;
+  }
+  if (version.size() != 8 || version.substr(0, 5) != "HTTP/" ||
+      !std::isdigit(static_cast<unsigned char>(version[5])) || version[6] != '.' ||
+      !std::isdigit(static_cast<unsigned char>(version[7]))) {
+    return false;
+  }
+
+  method_ = {offset, method_end};
+  method_id_ = ParseMethod(method);
+  path_ = {offset + method_end + 1, path_end - method_end - 1};
+  version_ = {offset + path_end + 1, version.size()};
+  return true;
+}
+
+bool RequestParser::ParseHeaderLine(std::string_view line, size_t offset, size_t colon) {
+  if (colon == 0) {
+    return false;
+  }
+  std::string_view name = line.substr(0, colon);
+
+  // Trim optional whitespace around the value
+  size_t value_start = colon + 1;
+  size_t value_end = line.size();
+  while (value_start < value_end && (line[value_start] == ' ' || line[value_start] == '\t')) ++value_start;
+  while (value_end > value_start && (line[value_end - 1] == ' ' || line[value_end - 1] == '\t')) --value_end;
+  std::string_view value = line.substr(value_start, value_end - value_start);
+
+  // Recognised once here; the request's slots and the framing checks below reuse it
+  HttpHeader header = ParseHeader(name);
+  if (header == HttpHeader::CONTENT_LENGTH) {
+    size_t length = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), length);
+    if (value.empty() || error != std::errc() || end != value.data() + value.size()) {
+      return false;
+    }
+    // Conflicting lengths would let two parsers frame the stream differently
+    if (has_content_length_ && length != content_length_) {
+      return false;
+    }
+    content_length_ = length;
+    has_content_length_ = true;
+  } else if (header == HttpHeader::TRANSFER_ENCODING) {
+    // Chunked request bodies are not supported: refuse rather than misframe
+    Fail(501);
+    return false;
+  }
+
+  headers_.push_back({Span{offset, colon}, Span{offset + value_start, value.size()}, header});
+  return true;
+}
+
+void RequestParser::Fill(std::string_view data, Request& request) const {
+  auto view = [data](Span span) { return data.substr(span.offset, span.length); };
+
+  // Only views are stored: the request aliases the caller's buffer
+  request.method_ = view(method_);
+  request.method_id_ = method_id_;
+  request.path_ = view(path_);
+  request.version_ = view(version_);
+  request.body_ = data.substr(body_start_, content_length_);
+  request.ClearHeaders();
+  request.param_count_ = 0;
+  for (const Field& field : headers_) {
+    request.AddHeader(view(field.name), view(field.value), field.header);
+  }
+}
+
+RequestParser::Result RequestParser::Fail(int status) {
+  state_ = State::ERROR;
+  error_status_ = status;
+  return Result::ERROR;
+}
+
+void RequestParser::Reset() {
+  state_ = State::REQUEST_LINE;
+  line_start_ = 0;
+  scan_position_ = 0;
+  body_start_ = 0;
+  content_length_ = 0;
+  has_content_length_ = false;
+  error_status_ = 0;
+  method_id_ = HttpMethod::OTHER;
+  headers_.clear();
+  scanner_.NextLine();
+}
+
+} // namespace revak
@@ -7,11 +7,11 @@
  */
 
 #include "revak/Response.h"
+#include "revak/DateCache.h"
+#include "revak/HttpStatus.h"
 
-#include <chrono>
+#include <charconv>
 #include <string>
-#include <format>
-#include <ctime>
 
 namespace revak {
 
@@ -19,69 +19,137 @@ void Response::SetStatus(int code) {
   status_code_ = code;
 }
 
-void Response::SetHeader(std::string key, std::string value) {
-  headers_[std::move(key)] = std::move(value);
+void Response::SetHeader(std::string_view key, std::string_view value) {
+  has_content_length_ = has_content_length_ || ParseHeader(key) == HttpHeader::CONTENT_LENGTH;
+  auto it = headers_.find(key);
+  if (it != headers_.end()) {
+    it->second = value;
+  } else {
+    headers_.emplace(key, value);
+  }
+}
+
+std::string_view Response::GetHeader(std::string_view key) const {
+  auto it = headers_.find(key);
+  return it == headers_.end() ? std::string_view() : std::string_view(it->second);
 }
 
 void Response::SetBody(std::string body) {
+  serialized_ = false;
   body_ = std::move(body);
+  shared_body_.reset();
+  shared_view_ = {};
+  file_body_.reset();
+  stream_body_ = nullptr;
+}
+
+void Response::SetSharedBody(std::shared_ptr<const std::string> buffer, size_t offset, size_t length) {
+  body_.clear();
+  shared_view_ = std::string_view(*buffer).substr(offset, length);
+  shared_body_ = std::move(buffer);
+  serialized_ = false;
+  file_body_.reset();
+  stream_body_ = nullptr;
+}
+
+void Response::SetSerialized(std::shared_ptr<const std::string> buffer) {
+  SetSharedBody(std::move(buffer));
+  serialized_ = true;
+}
+
+void Response::SetFileBody(FileRegion region) {
+  serialized_ = false;
+  body_.clear();
+  shared_body_.reset();
+  shared_view_ = {};
+  file_body_ = std::move(region);
+  stream_body_ = nullptr;
+}
+
+void Response::SetStreamBody(BodyStream stream) {
+  serialized_ = false;
+  body_.clear();
+  shared_body_.reset();
+  shared_view_ = {};
+  file_body_.reset();
+  stream_body_ = std::move(stream);
 }
 
 int Response::GetStatusCode() const {
   return status_code_;
 }
 
-std::string Response::GetStatusText() const {
-  switch (status_code_) {
-  case 200: return "OK";
-  case 201: return "Created";
-  case 204: return "No Content";
-  case 301: return "Moved Permanently";
-  case 302: return "Found";
-  case 304: return "Not Modified";
-  case 401: return "Unauthorized";
-  case 403: return "Forbidden";
-  case 404: return "Not Found";
-  case 405: return "Method Not Allowed";
-  case 500: return "Internal Server Error";
-  case 502: return "Bad Gateway";
-  case 503: return "Service Unavailable";
-  default:  return "Unknown";
-  }
+std::string_view Response::GetStatusText() const {
+  return StatusText(status_code_);
+}
+
+std::string_view Response::GetBody() const {
+  return shared_body_ ? shared_view_ : std::string_view(body_);
 }
 
 std::string Response::ToString() const {
+  std::string_view body = GetBody();
+  std::string out;
+  out.reserve(256 + body.size());
+  SerializeHead(out);
+  out += body;
+  return out;
+}
+
+void Response::SerializeHead(std::string& out) const {
+  // Everything is appended in place: no temporaries, the body is not touched
+  char number[24];
+  auto append_number = [&out, &number](size_t value) {
+    auto result = std::to_chars(number, number + sizeof(number), value);
+    out.append(number, result.ptr);
+  };
+
+  // Registered codes use their pre-rendered line, others are rendered here
+  std::string_view status_line = StatusLine(status_code_);
+  if (!status_line.empty()) {
+    out += status_line;
+  } else {
+    out += "HTTP/1.1 ";
+    append_number(static_cast<size_t>(status_code_));
+    out += " Unknown\r\n";
+  }
+
+  // Add Server and Date headers; the date is formatted once per second
+  out += "Server: Revak\r\nDate: ";
+  DateCache::Instance().Append(out);
+  out += "\r\n";
 
-  std::string status_line = 
-    std::format("HTTP/1.1 {} {}\r\n", status_code_, GetStatusText());
-
-  std::string headers;
-  
-  // Get current time in UTC for Date header
-  auto now = std::chrono::system_clock::now();
-  auto now_t = std::chrono::system_clock::to_time_t(now);
-  
-  // Convert to UTC time struct
-  std::tm utc_time = *std::gmtime(&now_t);
-  
-  // Format RFC 7231 compliant Date header (UTC/GMT)
-  char date_buffer[100];
-  std::strftime(date_buffer, sizeof(date_buffer), "%a, %d %b %Y %H:%M:%S GMT", &utc_time);
-
-  // Add Server and Date headers
-  headers += "Server: Revak\r\n";
-  headers += std::format("Date: {}\r\n", date_buffer);
-
-  // Set Content-Length header only if not already set by user
-  if (headers_.find("Content-Length") == headers_.end()) {
-    headers += std::format("Content-Length: {}\r\n", body_.size());
+  SerializeHeaders(out);
+
+  // A serialized buffer carries the rest of the header block and the empty line
+  if (!serialized_) {
+    out += "\r\n";
+  }
+}
+
+void Response::SerializeHeaders(std::string& out) const {
+  char number[24];
+
+  // Set Content-Length header only if not already set by user; 1xx, 204 and
+  // 304 responses have no body and must not announce one, and a streamed
+  // body is framed by chunks (or by closing the connection); a serialized
+  // buffer frames itself
+  bool bodiless = status_code_ < 200 || status_code_ == 204 || status_code_ == 304;
+  if (IsChunked()) {
+    out += "Transfer-Encoding: chunked\r\n";
+  } else if (!bodiless && !stream_body_ && !serialized_ && !has_content_length_) {
+    out += "Content-Length: ";
+    auto result = std::to_chars(number, number + sizeof(number), BodySize());
+    out.append(number, result.ptr);
+    out += "\r\n";
   }
-  
+
   for (const auto& [key, val] : headers_) {
-    headers += std::format("{}: {}\r\n", key, val);
+    out += key;
+    out += ": ";
+    out += val;
+    out += "\r\n";
   }
-  headers += "\r\n";
-  return status_line + headers + body_;
 }
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
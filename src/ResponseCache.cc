@@ -0,0 +1,219 @@
+/**
+ * @file ResponseCache.cc
+ * @brief ResponseCache class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/ResponseCache.h"
+#include "revak/Arena.h"
+#include "revak/Logger.h"
+
+#include <charconv>
+#include <ctime>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+
+namespace revak {
+
+namespace {
+
+/** Headers a 304 repeats from the 200 it stands for (RFC 9110 section 15.4.5) */
+constexpr std::string_view kNotModifiedHeaders[] = {"Cache-Control", "Content-Location", "ETag", "Expires", "Vary"};
+
+int64_t NowMillis() {
+  timespec ts{};
+  ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+/** Strong entity tag from a hash of the body */
+std::string BodyEtag(std::string_view body) {
+  char digits[16];
+  auto result = std::to_chars(digits, digits + sizeof(digits), std::hash<std::string_view>{}(body), 16);
+  std::string etag = "\"";
+  etag.append(digits, result.ptr);
+  etag += '"';
+  return etag;
+}
+
+} // namespace
+
+struct ResponseCache::Entry {
+  /** Method, target and vary header values, separated by line feeds */
+  std::string key;
+
+  /** Entity tag of the body */
+  std::string etag;
+
+  /** Header lines, empty line and body of the 200 response */
+  std::shared_ptr<const std::string> full;
+
+  /** Header lines and empty line of the 304 response */
+  std::shared_ptr<const std::string> not_modified;
+
+  /** Monotonic time the entry stops being served, in milliseconds */
+  int64_t expires_at{0};
+
+  /** Bytes charged against the budget */
+  size_t size{0};
+};
+
+ResponseCache::ResponseCache(size_t max_bytes) {
+  SetMaxBytes(max_bytes);
+}
+
+Response ResponseCache::Serve(const Request& request, const Handler& handler, const CacheOptions& options) {
+  // Header values cannot hold a line feed, so it separates the parts unambiguously
+  std::pmr::string key(CurrentMemoryResource());
+  key += request.Method();
+  key += '\n';
+  key += request.Path();
+  for (const std::string& name : options.vary) {
+    key += '\n';
+    key += request.Header(name);
+  }
+
+  Shard& shard = shards_[std::hash<std::string_view>{}(key) % kShards];
+  std::shared_ptr<const Entry> entry = Find(shard, key);
+  if (!entry) {
+    Response response = handler(request);
+    entry = MakeEntry(key, response, options);
+    if (!entry) {
+      return response;
+    }
+    if (!Insert(shard, entry) && !oversize_reported_.exchange(true, std::memory_order_relaxed)) {
+      // Served, just not kept; reported once, a route over the limit would otherwise log every request
+      Logger::Instance().Log(Logger::Level::WARNING,
+                             std::format("Response cache: {} response of {} bytes exceeds the {} bytes an entry "
+                                         "may take (max bytes / {}), not cached",
+                                         request.Path(), entry->size, shard_max_bytes_.load(std::memory_order_relaxed),
+                                         kShards));
+    }
+  }
+
+  Response response;
+  if (request.MatchesEtag(entry->etag)) {
+    response.SetStatus(304);
+    response.SetSerialized(entry->not_modified);
+  } else {
+    response.SetSerialized(entry->full);
+  }
+  return response;
+}
+
+void ResponseCache::SetMaxBytes(size_t max_bytes) {
+  shard_max_bytes_.store(max_bytes / kShards, std::memory_order_relaxed);
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.max_bytes = max_bytes / kShards;
+    while (shard.bytes > shard.max_bytes) {
+      Erase(shard, std::prev(shard.lru.end()));
+    }
+  }
+}
+
+void ResponseCache::Clear() {
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.bytes = 0;
+  }
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::Find(Shard& shard, std::string_view key) {
+  int64_t now = NowMillis();
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    return nullptr;
+  }
+  auto position = it->second;
+  if ((*position)->expires_at <= now) {
+    Erase(shard, position);
+    return nullptr;
+  }
+  shard.lru.splice(shard.lru.begin(), shard.lru, position);
+  return *position;
+}
+
+bool ResponseCache::Insert(Shard& shard, std::shared_ptr<const Entry> entry) {
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (entry->size > shard.max_bytes) {
+    return false;
+  }
+  // Concurrent misses of one key each run the handler; the last one stays
+  auto it = shard.index.find(entry->key);
+  if (it != shard.index.end()) {
+    Erase(shard, it->second);
+  }
+
+  shard.bytes += entry->size;
+  shard.lru.push_front(std::move(entry));
+  shard.index.emplace(shard.lru.front()->key, shard.lru.begin());
+  while (shard.bytes > shard.max_bytes) {
+    Erase(shard, std::prev(shard.lru.end()));
+  }
+  return true;
+}
+
+void ResponseCache::Erase(Shard& shard, std::list<std::shared_ptr<const Entry>>::iterator position) {
+  shard.bytes -= (*position)->size;
+  shard.index.erase((*position)->key);
+  shard.lru.erase(position);
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::MakeEntry(std::string_view key, Response& response,
+                                                                     const CacheOptions& options) {
+  if (response.GetStatusCode() != 200 || response.IsStreamed() || response.GetFileBody() != nullptr ||
+      !response.GetHeader("Set-Cookie").empty() || !response.GetHeader("Connection").empty() ||
+      response.GetHeader("Cache-Control").find("no-store") != std::string_view::npos) {
+    return nullptr;
+  }
+
+  if (response.GetHeader("ETag").empty()) {
+    response.SetHeader("ETag", BodyEtag(response.GetBody()));
+  }
+  if (!options.vary.empty() && response.GetHeader("Vary").empty()) {
+    std::string vary;
+    for (const std::string& name : options.vary) {
+      vary += vary.empty() ? "" : ", ";
+      vary += name;
+    }
+    response.SetHeader("Vary", vary);
+  }
+
+  // Outlives the request: allocated from the heap, not the connection's arena
+  auto entry = std::make_shared<Entry>();
+  entry->key = key;
+  entry->etag = response.GetHeader("ETag");
+
+  auto full = std::make_shared<std::string>();
+  response.SerializeHeaders(*full);
+  *full += "\r\n";
+  *full += response.GetBody();
+
+  auto not_modified = std::make_shared<std::string>();
+  for (std::string_view name : kNotModifiedHeaders) {
+    std::string_view value = response.GetHeader(name);
+    if (!value.empty()) {
+      *not_modified += name;
+      *not_modified += ": ";
+      *not_modified += value;
+      *not_modified += "\r\n";
+    }
+  }
+  *not_modified += "\r\n";
+
+  entry->size = sizeof(Entry) + entry->key.size() + entry->etag.size() + full->size() + not_modified->size();
+  entry->full = std::move(full);
+  entry->not_modified = std::move(not_modified);
+  entry->expires_at = NowMillis() + options.ttl.count();
+  return entry;
+}
+
+} // namespace revak
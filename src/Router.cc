@@ -7,13 +7,155 @@
  */
 
 #include "revak/Router.h"
+#include "revak/Epoch.h"
 #include "revak/Logger.h"
 
+#include <algorithm>
+#include <array>
+#include <format>
+#include <utility>
+#include <vector>
+
 namespace revak {
 
+/**
+ * @struct Router::Endpoint
+ * @brief Handler of one method of a route, with the route's id
+ */
+struct Router::Endpoint {
+  std::string method;
+
+  /** Recognised method, compared first; the text only decides for HttpMethod::OTHER */
+  HttpMethod method_id;
+
+  /** Route record, kept alive by the table holding this endpoint */
+  const Route* route;
+
+  size_t route_id;
+};
+
+/**
+ * @struct Router::Node
+ * @brief Radix tree node: a static prefix, or a parameter / wildcard segment
+ *
+ * Nodes are shared between the published tree and the trees built by
+ * later updates, and never modified once published.
+ */
+struct Router::Node {
+  /** Static text matched by this node, empty for parameter and wildcard nodes */
+  std::string prefix;
+
+  /** First byte of each static child's prefix, parallel to static_children */
+  std::string indices;
+
+  /** Children continuing with static text */
+  std::vector<std::shared_ptr<Node>> static_children;
+
+  /** Child capturing one path segment (":name") */
+  std::shared_ptr<Node> param_child;
+
+  /** Child capturing the rest of the path ("*name") */
+  std::shared_ptr<Node> wildcard_child;
+
+  /** Name captured by a parameter or wildcard node */
+  std::string param_name;
+
+  /** Handlers of the route ending at this node, by method */
+  std::vector<Endpoint> handlers;
+
+  /** Allow header value listing the methods of this route */
+  std::string allow;
+};
+
+/**
+ * @struct Router::Table
+ * @brief One published version of the routes
+ *
+ * The routes by id are kept in chunks shared between versions too, so an
+ * update copies one chunk rather than every route ever added.
+ */
+struct Router::Table {
+  /** Routes per chunk */
+  static constexpr size_t kChunkSize = 64;
+
+  using Chunk = std::array<std::shared_ptr<const Route>, kChunkSize>;
+
+  /** Root of the radix tree (the empty prefix) */
+  std::shared_ptr<Node> root{std::make_shared<Node>()};
+
+  /** Every route added, removed ones included, by id */
+  std::vector<std::shared_ptr<Chunk>> chunks;
+
+  /** Number of route ids taken */
+  size_t route_count{0};
+
+  /** Compile-time routes, looked up before the tree */
+  RouteTableView statics;
+
+  /** Id of the first route of statics, the others follow in table order */
+  size_t static_first_id{0};
+
+  /** @return Route of an id below route_count */
+  const std::shared_ptr<const Route>& At(size_t id) const { return (*chunks[id / kChunkSize])[id % kChunkSize]; }
+
+  /**
+   * @brief Replace the route of an id, copying its chunk
+   * @param id Id below route_count
+   * @param route New record
+   */
+  void Set(size_t id, std::shared_ptr<const Route> route) {
+    std::shared_ptr<Chunk>& chunk = chunks[id / kChunkSize];
+    chunk = std::make_shared<Chunk>(*chunk);
+    (*chunk)[id % kChunkSize] = std::move(route);
+  }
+
+  /**
+   * @brief Give the next id to a route
+   * @param route New record
+   */
+  void Append(std::shared_ptr<const Route> route) {
+    if (route_count % kChunkSize == 0) {
+      chunks.push_back(std::make_shared<Chunk>());
+    }
+    ++route_count;
+    Set(route_count - 1, std::move(route));
+  }
+};
+
+namespace {
+
+/**
+ * @brief Run a coroutine handler, holding its route
+ *
+ * The coroutine frame may point into the handler (a lambda's captures),
+ * which removing the route frees once no dispatch holds the old table.
+ */
+Task<Response> RunAsync(std::shared_ptr<const Route> route, const Request& request) {
+  co_return co_await route->async_handler(request);
+}
+
+} // namespace
+
+Router::Router() : table_(new Table()) {}
+
+Router::~Router() {
+  delete table_.load(std::memory_order_relaxed);
+}
+
 bool Router::AddRoute(const std::string& method, const std::string& path, Handler handler) {
+  return AddEndpoint({method, path, std::move(handler), nullptr});
+}
+
+bool Router::AddRoute(const std::string& method, const std::string& path, AsyncHandler handler) {
+  return AddEndpoint({method, path, nullptr, std::move(handler)});
+}
+
+bool Router::AddEndpoint(Route route) {
+  const std::string& method = route.method;
+  const std::string& path = route.path;
+
   // Basic validation
-  if (method.empty() || path.empty() || !handler) {
+  if (method.empty() || path.empty() || (!route.handler && !route.async_handler)) {
     Logger::Instance().Log(Logger::Level::ERROR, "Failed to add route: Invalid parameters");
     return false;
   }
@@ -24,33 +166,382 @@ bool Router::AddRoute(const std::string& method, const std::string& path, Handle
     return false;
   }
 
-  auto& method_map = routes_[method];
+  auto fail = [&path](const char* reason) {
+    Logger::Instance().Log(Logger::Level::ERROR, std::format("Failed to add route {}: {}", path, reason));
+    return false;
+  };
+
+  // The new table is built aside; a failure drops it and leaves the routes as they were
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  auto table = std::make_unique<Table>(*table_.load(std::memory_order_relaxed));
+  Node* node = Own(table->root);
+  size_t param_count = 0;
+  size_t i = 0;
+  while (i < path.size()) {
+    if (path[i] != ':' && path[i] != '*') {
+      size_t end = std::min(path.find_first_of(":*", i), path.size());
+      if (end < path.size() && path[end - 1] != '/') {
+        return fail("parameters must start a path segment");
+      }
+      node = InsertStatic(node, std::string_view(path).substr(i, end - i));
+      i = end;
+      continue;
+    }
+
+    bool wildcard = path[i] == '*';
+    size_t end = std::min(path.find('/', i), path.size());
+    std::string_view name = std::string_view(path).substr(i + 1, end - i - 1);
+    if (name.empty()) {
+      return fail("parameter name is missing");
+    }
+    if (wildcard && end != path.size()) {
+      return fail("a wildcard must be the last segment");
+    }
+    if (++param_count > Request::kMaxParams) {
+      return fail("too many parameters");
+    }
+
+    std::shared_ptr<Node>& child = wildcard ? node->wildcard_child : node->param_child;
+    if (!child) {
+      child = std::make_shared<Node>();
+      child->param_name = name;
+    } else if (child->param_name != name) {
+      // Two names at one position would make Param() ambiguous
+      return fail("conflicts with an existing parameter name at the same position");
+    } else {
+      Own(child);
+    }
+    node = child.get();
+    i = end;
+  }
+
+  for (const Endpoint& existing : node->handlers) {
+    if (existing.method == method) {
+      Logger::Instance().Log(Logger::Level::WARNING, "Route already exists: " + method + " " + path);
+      return false;
+    }
+  }
+
+  auto record = std::make_shared<const Route>(std::move(route));
+  node->handlers.push_back({record->method, ParseMethod(record->method), record.get(), table->route_count});
+  node->allow += node->allow.empty() ? record->method : ", " + record->method;
+  Logger::Instance().Log(Logger::Level::INFO, "Route added: " + record->method + " " + record->path);
+  table->Append(std::move(record));
+  Publish(std::move(table));
+  return true;
+}
+
+bool Router::RemoveRoute(const std::string& method, const std::string& path) {
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  auto table = std::make_unique<Table>(*table_.load(std::memory_order_relaxed));
+
+  // Walk the pattern, owning the nodes on the way and remembering the links to them
+  std::vector<std::shared_ptr<Node>*> trail{&table->root};
+  Node* node = Own(table->root);
+  size_t i = 0;
+  while (node != nullptr && i < path.size()) {
+    if (path[i] != ':' && path[i] != '*') {
+      size_t end = std::min(path.find_first_of(":*", i), path.size());
+      std::string_view text = std::string_view(path).substr(i, end - i);
+      while (node != nullptr && !text.empty()) {
+        size_t index = node->indices.find(text[0]);
+        if (index == std::string::npos || !text.starts_with(node->static_children[index]->prefix)) {
+          node = nullptr;
+          break;
+        }
+        std::shared_ptr<Node>& child = node->static_children[index];
+        text.remove_prefix(child->prefix.size());
+        trail.push_back(&child);
+        node = Own(child);
+      }
+      i = end;
+      continue;
+    }
+
+    size_t end = std::min(path.find('/', i), path.size());
+    std::shared_ptr<Node>& child = path[i] == '*' ? node->wildcard_child : node->param_child;
+    if (!child || child->param_name != std::string_view(path).substr(i + 1, end - i - 1)) {
+      node = nullptr;
+      break;
+    }
+    trail.push_back(&child);
+    node = Own(child);
+    i = end;
+  }
+
+  std::vector<Endpoint>::iterator endpoint;
+  if (node != nullptr) {
+    endpoint = std::find_if(node->handlers.begin(), node->handlers.end(),
+                            [&method](const Endpoint& candidate) { return candidate.method == method; });
+  }
+  if (node == nullptr || endpoint == node->handlers.end()) {
+    Logger::Instance().Log(Logger::Level::WARNING, "Route not found: " + method + " " + path);
+    return false;
+  }
+
+  // The id stays taken, its name labels the metrics recorded under it
+  size_t id = endpoint->route_id;
+  table->Set(id, std::make_shared<const Route>(Route{method, table->At(id)->path, nullptr, nullptr}));
+  node->handlers.erase(endpoint);
+  node->allow.clear();
+  for (const Endpoint& remaining : node->handlers) {
+    node->allow += node->allow.empty() ? remaining.method : ", " + remaining.method;
+  }
 
-  if (method_map.contains(path)) {
-    Logger::Instance().Log(Logger::Level::WARNING, "Route already exists: " + method + " " + path);
+  // Nodes left without routes go, so a later route may name their parameters differently
+  size_t k = trail.size() - 1;
+  for (; k > 0; --k) {
+    const Node& empty = **trail[k];
+    if (!empty.handlers.empty() || !empty.static_children.empty() || empty.param_child || empty.wildcard_child) {
+      break;
+    }
+    Node& parent = **trail[k - 1];
+    if (trail[k] == &parent.param_child || trail[k] == &parent.wildcard_child) {
+      trail[k]->reset();
+    } else {
+      auto index = trail[k] - parent.static_children.data();
+      parent.static_children.erase(parent.static_children.begin() + index);
+      parent.indices.erase(static_cast<size_t>(index), 1);
+    }
+  }
+
+  // A static node left with one static child and nothing else merges into it, undoing the split
+  // that made it, so matching does not walk one node more for every route added and removed
+  Node& rest = **trail[k];
+  if (k > 0 && rest.param_name.empty() && rest.handlers.empty() && !rest.param_child && !rest.wildcard_child
+      && rest.static_children.size() == 1) {
+    std::shared_ptr<Node> only = rest.static_children.front();
+    Own(only)->prefix.insert(0, rest.prefix);
+    *trail[k] = std::move(only);
+  }
+
+  Logger::Instance().Log(Logger::Level::INFO, "Route removed: " + method + " " + path);
+  Publish(std::move(table));
+  return true;
+}
+
+bool Router::SetRouteTable(RouteTableView routes) {
+  if (routes.Empty()) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to set route table: no routes");
     return false;
   }
 
-  method_map[path] = std::move(handler);
-  Logger::Instance().Log(Logger::Level::INFO, "Route added: " + method + " " + path);
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  auto table = std::make_unique<Table>(*table_.load(std::memory_order_relaxed));
+  for (size_t i = 0; i < table->statics.Size(); ++i) {
+    size_t id = table->static_first_id + i;
+    table->Set(id, std::make_shared<const Route>(Route{table->At(id)->method, table->At(id)->path, nullptr, nullptr}));
+  }
+
+  // Records for GetRoute() and the metrics; dispatching calls the functions directly
+  table->statics = routes;
+  table->static_first_id = table->route_count;
+  for (size_t i = 0; i < routes.Size(); ++i) {
+    const StaticRoute& route = routes.Route(i);
+    table->Append(std::make_shared<const Route>(
+        Route{std::string(route.method), std::string(route.path), route.handler, nullptr}));
+  }
+  Logger::Instance().Log(Logger::Level::INFO, std::format("Route table set: {} routes", routes.Size()));
+  Publish(std::move(table));
   return true;
 }
 
-Response Router::Dispatch(const Request& request) {
-  Logger::Instance().Log(Logger::Level::INFO, "Request received: " + request.Method() + " " + request.Path());
-  auto method_it = routes_.find(request.Method());
-  if (method_it != routes_.end()) {
-    auto path_it = method_it->second.find(request.Path());
-    if (path_it != method_it->second.end()) {
-      Logger::Instance().Log(Logger::Level::INFO, "Dispatching to handler for: " 
-                             + request.Method() + " " + request.Path());
-      return path_it->second(request);
+size_t Router::RouteCount() const {
+  Epoch::Guard guard;
+  return table_.load(std::memory_order_acquire)->route_count;
+}
+
+std::shared_ptr<const Route> Router::GetRoute(size_t id) const {
+  Epoch::Guard guard;
+  const Table& table = *table_.load(std::memory_order_acquire);
+  return id < table.route_count ? table.At(id) : nullptr;
+}
+
+void Router::Publish(std::unique_ptr<Table> table) {
+  const Table* previous = table_.exchange(table.release(), std::memory_order_acq_rel);
+  Epoch::Instance().Retire([previous] { delete previous; });
+}
+
+Router::Node* Router::Own(std::shared_ptr<Node>& node) {
+  node = std::make_shared<Node>(*node);
+  return node.get();
+}
+
+Router::Node* Router::InsertStatic(Node* node, std::string_view text) {
+  while (!text.empty()) {
+    size_t index = node->indices.find(text[0]);
+    if (index == std::string::npos) {
+      auto child = std::make_shared<Node>();
+      child->prefix = text;
+      node->indices += text[0];
+      node->static_children.push_back(std::move(child));
+      return node->static_children.back().get();
+    }
+
+    std::shared_ptr<Node>& child = node->static_children[index];
+    Own(child);
+    auto [text_end, prefix_end] = std::mismatch(text.begin(), text.end(), child->prefix.begin(), child->prefix.end());
+    size_t common = static_cast<size_t>(prefix_end - child->prefix.begin());
+
+    // Split the child so the shared part becomes its own node
+    if (common < child->prefix.size()) {
+      auto middle = std::make_shared<Node>();
+      middle->prefix = child->prefix.substr(0, common);
+      child->prefix.erase(0, common);
+      middle->indices += child->prefix[0];
+      middle->static_children.push_back(std::move(child));
+      child = std::move(middle);
+    }
+
+    node = child.get();
+    text.remove_prefix(common);
+  }
+  return node;
+}
+
+const Router::Node* Router::Match(const Node* node, std::string_view rest, Request& request) {
+  if (rest.empty()) {
+    if (!node->handlers.empty()) {
+      return node;
     }
+  } else {
+    // Static text first
+    size_t index = node->indices.find(rest[0]);
+    if (index != std::string::npos) {
+      const Node* child = node->static_children[index].get();
+      if (rest.starts_with(child->prefix)) {
+        if (const Node* found = Match(child, rest.substr(child->prefix.size()), request)) {
+          return found;
+        }
+      }
+    }
+
+    // Then one segment as a parameter, backtracking if the rest does not match
+    if (node->param_child) {
+      std::string_view segment = rest.substr(0, rest.find('/'));
+      if (!segment.empty()) {
+        size_t saved = request.param_count_;
+        request.params_[request.param_count_++] = {node->param_child->param_name, segment};
+        if (const Node* found = Match(node->param_child.get(), rest.substr(segment.size()), request)) {
+          return found;
+        }
+        request.param_count_ = saved;
+      }
+    }
+  }
+
+  // Finally the wildcard takes whatever is left
+  if (node->wildcard_child && !node->wildcard_child->handlers.empty()) {
+    request.params_[request.param_count_++] = {node->wildcard_child->param_name, rest};
+    return node->wildcard_child.get();
+  }
+  return nullptr;
+}
+
+Response Router::Dispatch(Request& request) {
+  Epoch::Guard guard;
+  const Table& table = *table_.load(std::memory_order_acquire);
+  const RouteTableView::Path* path = nullptr;
+  if (const StaticRoute* route = FindStatic(table, request, path)) {
+    return route->handler(request);
+  }
+  const Node* node = nullptr;
+  const Endpoint* endpoint = Find(table, request, node);
+  if (endpoint == nullptr) {
+    return Reject(table, node, path);
+  }
+  if (!endpoint->route->async_handler) {
+    return endpoint->route->handler(request);
+  }
+
+  // Without an executor the awaits block instead of suspending, so the task finishes here, within the guard
+  Task<Response> task = endpoint->route->async_handler(request);
+  task.Start(nullptr);
+  return task.Result();
+}
+
+std::optional<Response> Router::TryDispatch(Request& request, Task<Response>& task) {
+  // Held while a plain handler runs: removing its route frees it with the table
+  Epoch::Guard guard;
+  const Table& table = *table_.load(std::memory_order_acquire);
+  const RouteTableView::Path* path = nullptr;
+  if (const StaticRoute* route = FindStatic(table, request, path)) {
+    return route->handler(request);
+  }
+  const Node* node = nullptr;
+  const Endpoint* endpoint = Find(table, request, node);
+  if (endpoint == nullptr) {
+    return Reject(table, node, path);
+  }
+  if (endpoint->route->async_handler) {
+    // The task outlives the guard, so it holds the route itself
+    task = RunAsync(table.At(endpoint->route_id), request);
+    return std::nullopt;
+  }
+  return endpoint->route->handler(request);
+}
+
+const Router::Endpoint* Router::Find(const Table& table, Request& request, const Node*& node) {
+  REVAK_LOG(DEBUG, "Request received: {} {}", request.Method(), request.Path());
+
+  // The query string takes no part in routing
+  std::string_view path = request.Path();
+  path = path.substr(0, path.find('?'));
+
+  request.param_count_ = 0;
+  request.route_id_ = Request::kNoRoute;
+  node = Match(table.root.get(), path, request);
+  if (node == nullptr) {
+    return nullptr;
+  }
+  for (const Endpoint& endpoint : node->handlers) {
+    if (endpoint.method_id == request.MethodId()
+        && (endpoint.method_id != HttpMethod::OTHER || endpoint.method == request.Method())) {
+      REVAK_LOG(DEBUG, "Dispatching to handler for: {} {}", request.Method(), request.Path());
+      request.route_id_ = endpoint.route_id;
+      return &endpoint;
+    }
+  }
+  return nullptr;
+}
+
+const StaticRoute* Router::FindStatic(const Table& table, Request& request, const RouteTableView::Path*& path) {
+  path = nullptr;
+  if (table.statics.Empty()) {
+    return nullptr;
   }
+
+  std::string_view target = request.Path();
+  path = table.statics.FindPath(target.substr(0, target.find('?')));
+  if (path == nullptr) {
+    return nullptr;
+  }
+  uint32_t index = table.statics.FindMethod(*path, request.MethodId(), request.Method());
+  if (index == RouteTableView::kEmpty) {
+    return nullptr;
+  }
+  REVAK_LOG(DEBUG, "Dispatching to static handler for: {} {}", request.Method(), request.Path());
+  request.param_count_ = 0;
+  request.route_id_ = table.static_first_id + index;
+  return &table.statics.Route(index);
+}
+
+Response Router::Reject(const Table& table, const Node* node, const RouteTableView::Path* path) {
   Response response;
+  if (node != nullptr || path != nullptr) {
+    std::string allow = node != nullptr ? node->allow : "";
+    if (path != nullptr) {
+      table.statics.AppendAllow(*path, allow);
+    }
+    response.SetStatus(405);
+    response.SetHeader("Allow", allow);
+    response.SetBody("405 Method Not Allowed\n");
+    return response;
+  }
+
   response.SetStatus(404);
   response.SetBody("404 Not Found\n");
   return response;
 }
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
@@ -9,20 +9,165 @@
 #include "revak/Server.h"
 #include "revak/Logger.h"
 
+#include <sys/epoll.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <optional>
 #include <unistd.h>
 
 namespace revak {
 
-Server::Server(uint16_t port, size_t thread_nums)
-  : port_(port), thread_nums_(thread_nums), running_(false), thread_pool_(thread_nums)  {
-  socket_ = Socket();
-  if (!socket_.Bind(port_)) {
-    Logger::Instance().Log(Logger::Level::ERROR, "Failed to bind server to port " + std::to_string(port_));
-    return;
+namespace {
+
+/** Submission queue size of an io_uring reactor */
+constexpr unsigned kRingEntries = 1024;
+
+/** Provided receive buffers of an io_uring reactor: count (power of two), size and group id */
+constexpr uint16_t kRecvBufferCount = 512;
+constexpr uint32_t kRecvBufferSize = 8192;
+constexpr uint16_t kRecvBufferGroup = 0;
+
+/**
+ * Kind of operation carried in the low bits of an io_uring user_data; the
+ * other bits hold the RingConnection, whose alignment leaves them zero.
+ */
+enum RingTag : uint64_t {
+  kAcceptTag = 0,
+  kLoopTag = 1,
+  kRecvTag = 2,
+  kSendTag = 3,
+  kPollTag = 4,
+  kCancelTag = 5,
+};
+constexpr uint64_t kRingTagMask = 7;
+
+template <typename T>
+uint64_t RingUserData(T* object, RingTag tag) {
+  static_assert(alignof(T) > kRingTagMask, "tag bits must be free in the address");
+  return reinterpret_cast<uint64_t>(object) | tag;
+}
+
+/** Response of a finished coroutine handler, 500 if it threw */
+Response TaskResponse(Task<Response>& task) {
+  try {
+    return task.Result();
+  } catch (const std::exception& e) {
+    REVAK_LOG(ERROR, "Coroutine handler failed: {}", e.what());
+  } catch (...) {
+    REVAK_LOG(ERROR, "Coroutine handler failed with an unknown exception");
   }
-  if (!socket_.Listen()) {
-    Logger::Instance().Log(Logger::Level::ERROR, "Failed to listen on port " + std::to_string(port_));
-    return;
+  Response response;
+  response.SetStatus(500);
+  response.SetBody("500 Internal Server Error\n");
+  return response;
+}
+
+/** Seconds an overloaded server asks clients to wait before retrying */
+constexpr int kRetryAfterSeconds = 1;
+
+/** Queued batches beyond which new ones are answered 503 */
+constexpr size_t kDefaultMaxQueued = 4096;
+
+/** Most pipelined requests answered by one batch, the rest are parsed after it */
+constexpr size_t kMaxBatchRequests = 64;
+
+/** Header lines and body of the overload 503, serialized once and shared by every response */
+const std::shared_ptr<const std::string>& OverloadResponse() {
+  static const std::shared_ptr<const std::string> serialized = [] {
+    Response response;
+    response.SetStatus(503);
+    response.SetHeader("Retry-After", std::to_string(kRetryAfterSeconds));
+    response.SetHeader("Content-Type", "text/plain");
+    response.SetBody("503 Service Unavailable\n");
+    auto buffer = std::make_shared<std::string>();
+    response.SerializeHeaders(*buffer);
+    *buffer += "\r\n";
+    *buffer += response.GetBody();
+    return buffer;
+  }();
+  return serialized;
+}
+
+/** Answer to a request that did not arrive in time; the connection is closed after it */
+Response RequestTimeoutResponse() {
+  Response response;
+  response.SetStatus(408);
+  response.SetBody("408 Request Timeout\n");
+  response.SetHeader("Connection", "close");
+  return response;
+}
+
+/** CPUs the process is allowed to run on */
+std::vector<int> AllowedCpus() {
+  std::vector<int> cpus;
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return cpus;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+/** Pin the calling thread to one CPU */
+void PinToCpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+    Logger::Instance().Log(Logger::Level::WARNING, std::format("Failed to pin shard thread to CPU {}", cpu));
+  }
+}
+
+} // namespace
+
+Server::Server(uint16_t port, size_t thread_nums, IoMode io_mode)
+  : port_(port), thread_nums_(thread_nums), io_mode_(io_mode), running_(false),
+    thread_pool_(io_mode == IoMode::SHARDED ? 0 : thread_nums)  {
+  thread_pool_.SetQueueLimit(kDefaultMaxQueued);
+
+  if (io_mode_ == IoMode::IO_URING && !IoUring::IsSupported()) {
+    Logger::Instance().Log(Logger::Level::WARNING, "io_uring is not available, falling back to epoll");
+    io_mode_ = IoMode::EPOLL;
+  }
+
+  // Sharded mode binds one listener per thread on the same port
+  size_t listeners = io_mode_ == IoMode::SHARDED ? std::max<size_t>(thread_nums_, 1) : 1;
+
+  for (size_t i = 0; i < listeners; i++) {
+    auto shard = std::make_unique<Shard>();
+    if (io_mode_ == IoMode::SHARDED && !shard->listener.SetReusePort()) {
+      shards_.clear();
+      return;
+    }
+    if (!shard->listener.Bind(port_)) {
+      Logger::Instance().Log(Logger::Level::ERROR, "Failed to bind server to port " + std::to_string(port_));
+      shards_.clear();
+      return;
+    }
+    if (!shard->listener.Listen()) {
+      Logger::Instance().Log(Logger::Level::ERROR, "Failed to listen on port " + std::to_string(port_));
+      shards_.clear();
+      return;
+    }
+
+    // Coroutine handlers resume where the shard's requests are handled
+    Executor::Schedule schedule = [this](std::function<void()> task) { thread_pool_.Enqueue(std::move(task)); };
+    if (io_mode_ == IoMode::SHARDED) {
+      schedule = [loop = &shard->loop](std::function<void()> task) { loop->Post(std::move(task)); };
+    }
+    shard->executor = std::make_unique<Executor>(shard->loop, std::move(schedule));
+    shards_.push_back(std::move(shard));
   }
   Logger::Instance().Log(Logger::Level::INFO, "Server started on port " + std::to_string(port_));
 }
@@ -33,67 +178,951 @@ Server::~Server() {
 }
 
 void Server::Run() {
+  if (shards_.empty()) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Server is not listening, nothing to run");
+    return;
+  }
+
   running_ = true;
+  switch (io_mode_) {
+    case IoMode::BLOCKING: RunBlocking(); break;
+    case IoMode::EPOLL: RunEventLoop(*shards_.front()); break;
+    case IoMode::SHARDED: RunSharded(); break;
+    case IoMode::IO_URING: RunIoUring(*shards_.front()); break;
+  }
+}
+
+void Server::RunBlocking() {
+  Shard& shard = *shards_.front();
+  Socket& listener = shard.listener;
+
+  // The loop only serves the waits of coroutine handlers, which may be added while running
+  std::thread loop_thread([&shard] { shard.loop.Run(); });
+
   while (running_) {
     // Accept incoming connection
-		Socket client = socket_.Accept();
+    Socket client = listener.Accept();
     if (client.NativeHandle() < 0) {
       continue; // Accept failed, try next
     }
-    // Use shared_ptr to manage client socket lifetime in threads
-		auto shared_client = std::make_shared<Socket>(std::move(client));
-
-		// Enqueue client handling task to the thread pool
-		thread_pool_.Enqueue([shared_client, this] {
-			// Buffer to store incoming data
-      char buffer[4096];
-      // Tech debt: Buffer overflow handling needed
-      ssize_t bytes_read = ::read(shared_client->NativeHandle(), buffer, sizeof(buffer));
-      if (bytes_read < 0) {
-        perror("read");
-        return;
-      } else if (bytes_read == 0) {
-        // Connection closed by client
+    client.SetReceiveTimeout(keep_alive_timeout_);
+    client.SetSendTimeout(write_timeout_);
+
+    // Use shared_ptr to manage client connection lifetime in threads
+    auto shared_client = std::make_shared<Connection>(std::move(client), parser_limits_);
+
+    if (metrics_) {
+      metrics_->ConnectionOpened();
+    }
+
+    // Enqueue client handling task to the thread pool; the task owns the
+    // connection until the client, the timeout or the request limit ends it
+    auto queued = std::chrono::steady_clock::now();
+    bool accepted = thread_pool_.TryEnqueue([shared_client, this, queued] {
+      if (!admission_.Admit(std::chrono::steady_clock::now() - queued)) {
+        RefuseConnection(*shared_client);
+        if (metrics_) {
+          metrics_->ConnectionClosed();
+        }
         return;
+      }
+      ServeBlocking(shared_client);
+    });
+    if (!accepted) {
+      RefuseConnection(*shared_client);
+      if (metrics_) {
+        metrics_->ConnectionClosed();
+      }
+    }
+  }
+
+  if (loop_thread.joinable()) {
+    loop_thread.join();
+  }
+}
+
+void Server::ServeBlocking(const std::shared_ptr<Connection>& connection) {
+  // The socket timeouts bound each blocking call; a request's header and body
+  // deadlines are turned into what is left of them before each read
+  Connection::Wait timed_wait = Connection::Wait::NONE;
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  std::chrono::milliseconds read_timeout = keep_alive_timeout_;
+
+  while (true) {
+    // A streamed body is pulled piece by piece as the blocking writes complete
+    Connection::IoStatus status;
+    while ((status = connection->Flush()) == Connection::IoStatus::OK && connection->NeedsStreamData()) {
+      connection->PullStreamData();
+    }
+    // Output left after a blocking flush means SO_SNDTIMEO expired: the client stopped reading
+    if (status != Connection::IoStatus::OK || connection->IsClosing() || connection->HasPendingOutput()) {
+      break;
+    }
+
+    int error_status = CollectRequests(*connection);
+
+    if (connection->Batch().empty() && error_status == 0) {
+      Connection::Wait wait = connection->Waiting();
+      std::chrono::milliseconds timeout = TimeoutOf(wait);
+      if (wait != Connection::Wait::IDLE && timeout.count() > 0) {
+        auto now = std::chrono::steady_clock::now();
+        if (wait != timed_wait) {
+          deadline = now + timeout;
+        }
+        // A zero SO_RCVTIMEO would wait forever
+        timeout = std::max(std::chrono::ceil<std::chrono::milliseconds>(deadline - now), std::chrono::milliseconds(1));
+      }
+      timed_wait = wait;
+      if (timeout != read_timeout && connection->SetReadTimeout(timeout)) {
+        read_timeout = timeout;
+      }
+
+      Connection::IoStatus read = connection->ReadOnce();
+      if (read == Connection::IoStatus::TIMEOUT && wait != Connection::Wait::IDLE) {
+        REVAK_LOG(DEBUG, "Request on connection {} timed out", connection->NativeHandle());
+        connection->QueueResponse(RequestTimeoutResponse());
+        connection->MarkClosing();
+        continue;
+      }
+      if (read != Connection::IoStatus::OK) {
+        break;
+      }
+      continue;
+    }
+    timed_wait = Connection::Wait::NONE; // The next request gets its own deadlines
+
+    // A suspended coroutine handler frees this thread, its completion serves the connection again
+    auto serve_again = [this, connection] { thread_pool_.Enqueue([this, connection] { ServeBlocking(connection); }); };
+    if (!HandleBatch(*shards_.front(), *connection, error_status, serve_again)) {
+      return;
+    }
+  }
+
+  if (metrics_) {
+    metrics_->ConnectionClosed();
+  }
+}
+
+void Server::RunSharded() {
+  // Spread the shards over the CPUs we may run on, wrapping if there are more shards
+  std::vector<int> cpus = AllowedCpus();
+
+  for (size_t i = 0; i < shards_.size(); i++) {
+    Shard* shard = shards_[i].get();
+    int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+    shard_threads_.emplace_back([this, shard, cpu] {
+      if (cpu >= 0) {
+        PinToCpu(cpu);
+      }
+      RunEventLoop(*shard);
+    });
+  }
+
+  for (std::thread& thread : shard_threads_) {
+    thread.join();
+  }
+  shard_threads_.clear();
+}
+
+void Server::RunEventLoop(Shard& shard) {
+  if (!shard.listener.SetNonBlocking()) {
+    return;
+  }
+  if (!shard.loop.Add(shard.listener.NativeHandle(), EPOLLIN, [this, &shard](uint32_t) { AcceptConnections(shard); })) {
+    return;
+  }
+
+  shard.loop.Run();
+}
+
+void Server::RunIoUring(Shard& shard) {
+  shard.ring = std::make_unique<IoUring>(kRingEntries);
+  if (!shard.ring->IsValid() || !shard.ring->SetupProvidedBuffers(kRecvBufferGroup, kRecvBufferCount, kRecvBufferSize)) {
+    Logger::Instance().Log(Logger::Level::WARNING, "io_uring setup failed, falling back to epoll");
+    shard.ring.reset();
+    io_mode_ = IoMode::EPOLL;
+    RunEventLoop(shard);
+    return;
+  }
+  IoUring& ring = *shard.ring;
+
+  // Posted tasks and timers stay on the event loop, whose epoll fd the ring watches
+  ring.PrepareAcceptMultishot(shard.listener.NativeHandle(), kAcceptTag);
+  ring.PreparePoll(shard.loop.NativeHandle(), POLLIN, true, kLoopTag);
+
+  // One system call per round submits everything the completions prepared
+  while (!shard.loop.IsStopped()) {
+    if (!ring.Submit(1)) {
+      break;
+    }
+    ring.ForEachCompletion([this, &shard](const io_uring_cqe& cqe) { OnRingCompletion(shard, cqe); });
+  }
+
+  // Closing the ring cancels what is still in flight
+  shard.ring.reset();
+}
+
+void Server::OnRingCompletion(Shard& shard, const io_uring_cqe& cqe) {
+  IoUring& ring = *shard.ring;
+  auto tag = static_cast<RingTag>(cqe.user_data & kRingTagMask);
+
+  switch (tag) {
+    case kAcceptTag: {
+      if (cqe.res >= 0) {
+        auto ring_connection = std::make_unique<RingConnection>(Socket::FromNativeHandle(cqe.res), parser_limits_);
+        RingConnection* raw = ring_connection.get();
+        raw->connection.Timeout().SetCallback([this, &shard, raw] { ExpireConnection(shard, &raw->connection); });
+        shard.ring_connections[cqe.res] = std::move(ring_connection);
+        if (metrics_) {
+          metrics_->ConnectionOpened();
+        }
+        ServeRingConnection(shard, raw); // Arms the recv
+      } else if (cqe.res != -ECANCELED && running_) {
+        Logger::Instance().Log(Logger::Level::ERROR, "Failed to accept incoming connection: " + std::string(std::strerror(-cqe.res)));
+      }
+      if (!IoUring::HasMore(cqe) && running_) {
+        ring.PrepareAcceptMultishot(shard.listener.NativeHandle(), kAcceptTag);
+      }
+      return;
+    }
+    case kLoopTag:
+      shard.loop.RunOnce(0);
+      if (!IoUring::HasMore(cqe)) {
+        ring.PreparePoll(shard.loop.NativeHandle(), POLLIN, true, kLoopTag);
+      }
+      return;
+    case kCancelTag:
+      return;
+    default:
+      break;
+  }
+
+  auto* ring_connection = reinterpret_cast<RingConnection*>(cqe.user_data & ~kRingTagMask);
+  Connection& connection = ring_connection->connection;
+
+  if (tag == kRecvTag) {
+    if (cqe.res > 0) {
+      uint16_t buffer = IoUring::BufferId(cqe);
+      std::string_view data(ring.Buffer(buffer), static_cast<size_t>(cqe.res));
+      if (ring_connection->closed) {
+        // Dropped
+      } else if (connection.IsBusy() || connection.HasPendingOutput() || !ring_connection->deferred_input.empty()) {
+        // The input buffer is viewed by requests in flight, keep the bytes aside
+        ring_connection->deferred_input.append(data);
       } else {
-        std::string request_data(buffer, bytes_read);
-        Request req = Request(request_data);
-        Response res = router_.Dispatch(req);
-        ::write(shared_client->NativeHandle(), res.ToString().c_str(), res.ToString().size());
-        Logger::Instance().Log(Logger::Level::INFO, "Handled " + req.Method() + " " + req.Path() + " with status " + std::to_string(res.GetStatusCode()));
+        connection.AppendInput(data);
       }
-		});
-	}
+      ring.RecycleBuffer(buffer);
+    } else if (cqe.res != -ENOBUFS && cqe.res != -ECANCELED) {
+      ring_connection->peer_closed = true; // FIN, or a socket error
+    }
+    if (!IoUring::HasMore(cqe)) {
+      ring_connection->receiving = false;
+      ring_connection->cancelling = false;
+      --ring_connection->operations;
+    }
+  } else if (tag == kSendTag) {
+    --ring_connection->sends;
+    --ring_connection->operations;
+    if (cqe.res >= 0) {
+      if (!ring_connection->closed) {
+        connection.CompleteOutput(static_cast<size_t>(cqe.res));
+      }
+    } else if (cqe.res != -ECANCELED) {
+      CloseRingConnection(shard, ring_connection); // Nothing more can be delivered, may destroy it
+      return;
+    }
+  } else if (tag == kPollTag) {
+    ring_connection->polling = false;
+    --ring_connection->operations;
+  }
+
+  if (ring_connection->closed) {
+    if (ring_connection->operations == 0) {
+      shard.ring_connections.erase(connection.NativeHandle());
+    }
+    return;
+  }
+  ServeRingConnection(shard, ring_connection);
 }
 
-bool Server::AddRoute(const std::string& method, const std::string& path, Handler handler) {
-  if (running_) {
-    Logger::Instance().Log(Logger::Level::WARNING, "Cannot add route while server is running.");
+void Server::ServeRingConnection(Shard& shard, RingConnection* ring_connection) {
+  IoUring& ring = *shard.ring;
+  Connection& connection = ring_connection->connection;
+
+  while (true) {
+    // A worker owns the buffers, or an output completion serves the connection again
+    if (ring_connection->closed) {
+      return;
+    }
+    if (connection.IsBusy() || ring_connection->sends > 0 || ring_connection->polling) {
+      UpdateTimeout(shard, connection);
+      return;
+    }
+
+    if (connection.HasPendingOutput()) {
+      if (SubmitRingSends(shard, ring_connection)) {
+        UpdateTimeout(shard, connection);
+        return;
+      }
+      // File and streamed bodies go out with the same non-blocking calls as in IoMode::EPOLL
+      if (connection.NeedsStreamData()) {
+        DispatchStreamPull(shard, &connection);
+        return;
+      }
+      if (connection.Flush() != Connection::IoStatus::OK) {
+        CloseRingConnection(shard, ring_connection);
+        return;
+      }
+      if (connection.HasPendingOutput() && !connection.NeedsStreamData()) {
+        if (ring.PreparePoll(connection.NativeHandle(), POLLOUT, false, RingUserData(ring_connection, kPollTag))) {
+          ring_connection->polling = true;
+          ++ring_connection->operations;
+        }
+        UpdateTimeout(shard, connection);
+        return;
+      }
+      continue;
+    }
+    if (connection.IsClosing()) {
+      CloseRingConnection(shard, ring_connection);
+      return;
+    }
+
+    if (!ring_connection->deferred_input.empty()) {
+      connection.AppendInput(ring_connection->deferred_input);
+      ring_connection->deferred_input.clear();
+    }
+
+    // Everything pipelined so far is answered by one task, in order
+    int error_status = CollectRequests(connection);
+    if (!connection.Batch().empty() || error_status != 0) {
+      if (ring_connection->peer_closed && connection.Batch().size() < kMaxBatchRequests) {
+        connection.MarkClosing(); // Answer what arrived before the peer's FIN
+      }
+      DispatchBatch(shard, &connection, error_status);
+      break;
+    }
+    if (ring_connection->peer_closed) {
+      CloseRingConnection(shard, ring_connection);
+      return;
+    }
+    break;
+  }
+
+  // Keep one multishot recv armed; it is cancelled while too much input waits
+  size_t input_limit = parser_limits_.max_header_size + parser_limits_.max_body_size;
+  if (ring_connection->deferred_input.size() > input_limit) {
+    if (ring_connection->receiving && !ring_connection->cancelling &&
+        ring.PrepareCancel(RingUserData(ring_connection, kRecvTag), kCancelTag)) {
+      ring_connection->cancelling = true;
+    }
+  } else if (!ring_connection->receiving && !ring_connection->peer_closed &&
+             ring.PrepareRecvMultishot(connection.NativeHandle(), kRecvBufferGroup, RingUserData(ring_connection, kRecvTag))) {
+    ring_connection->receiving = true;
+    ++ring_connection->operations;
+  }
+  UpdateTimeout(shard, connection);
+}
+
+bool Server::SubmitRingSends(Shard& shard, RingConnection* ring_connection) {
+  IoUring& ring = *shard.ring;
+  Connection& connection = ring_connection->connection;
+
+  bool file_follows = false;
+  size_t count = connection.GatherOutput(ring_connection->iov.data(), ring_connection->iov.size(), file_follows);
+  if (count == 0) {
     return false;
   }
-  
+
+  // MSG_WAITALL makes the kernel finish each send before the linked next one starts,
+  // so a chain is written in order and only an error leaves bytes unsent
+  size_t sends = (count + kRingSendIovecs - 1) / kRingSendIovecs;
+  if (ring.SpaceLeft() < sends) {
+    ring.Submit(0);
+  }
+  for (size_t i = 0; i < sends; ++i) {
+    msghdr& message = ring_connection->messages[i];
+    message = {};
+    message.msg_iov = ring_connection->iov.data() + i * kRingSendIovecs;
+    message.msg_iovlen = std::min(kRingSendIovecs, count - i * kRingSendIovecs);
+    bool last = i + 1 == sends;
+    unsigned flags = MSG_NOSIGNAL | MSG_WAITALL | (last && file_follows ? MSG_MORE : 0);
+    if (!ring.PrepareSendmsg(connection.NativeHandle(), &message, flags, !last, RingUserData(ring_connection, kSendTag))) {
+      break;
+    }
+    ++ring_connection->sends;
+    ++ring_connection->operations;
+  }
+  return ring_connection->sends > 0;
+}
+
+void Server::CloseRingConnection(Shard& shard, RingConnection* ring_connection) {
+  if (ring_connection->closed) {
+    return;
+  }
+  ring_connection->closed = true;
+  shard.loop.Timers().Cancel(ring_connection->connection.Timeout());
+  if (metrics_) {
+    metrics_->ConnectionClosed();
+  }
+
+  // Completes the armed operations; the fd stays open until the last one is reaped
+  int fd = ring_connection->connection.NativeHandle();
+  ::shutdown(fd, SHUT_RDWR);
+  if (ring_connection->receiving && !ring_connection->cancelling) {
+    shard.ring->PrepareCancel(RingUserData(ring_connection, kRecvTag), kCancelTag);
+  }
+  if (ring_connection->operations == 0) {
+    shard.ring_connections.erase(fd);
+  }
+}
+
+void Server::ResumeConnection(Shard& shard, Connection* connection) {
+  if (io_mode_ == IoMode::IO_URING) {
+    auto it = shard.ring_connections.find(connection->NativeHandle());
+    if (it != shard.ring_connections.end()) {
+      ServeRingConnection(shard, it->second.get());
+    }
+    return;
+  }
+  ServeConnection(shard, connection);
+}
+
+void Server::AcceptConnections(Shard& shard) {
+  // Edge-triggered: drain the whole backlog, a single accept could miss connections
+  while (running_) {
+    Socket client = shard.listener.Accept();
+    if (client.NativeHandle() < 0) {
+      return; // Backlog empty (or accept failed)
+    }
+    if (!client.SetNonBlocking()) {
+      continue;
+    }
+
+    int fd = client.NativeHandle();
+    auto connection = std::make_unique<Connection>(std::move(client), parser_limits_);
+    Connection* raw_connection = connection.get();
+    raw_connection->Timeout().SetCallback([this, &shard, raw_connection] { ExpireConnection(shard, raw_connection); });
+    shard.connections[fd] = std::move(connection);
+
+    // Register for both directions once; with EPOLLET this costs no extra wakeups
+    bool added = shard.loop.Add(fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP, [this, &shard, raw_connection](uint32_t events) {
+      if (events & EPOLLERR) {
+        if (raw_connection->IsBusy()) {
+          // The worker owns the connection state, HandBack() closes it
+          raw_connection->MarkErrorPending();
+        } else {
+          CloseConnection(shard, raw_connection);
+        }
+        return;
+      }
+      ServeConnection(shard, raw_connection);
+    });
+    if (!added) {
+      shard.connections.erase(fd);
+      continue;
+    }
+    if (metrics_) {
+      metrics_->ConnectionOpened();
+    }
+    UpdateTimeout(shard, *raw_connection);
+  }
+}
+
+void Server::ServeConnection(Shard& shard, Connection* connection) {
+  while (true) {
+    // A worker owns the buffers, the completion callback serves the connection again
+    if (connection->IsBusy()) {
+      return;
+    }
+
+    if (connection->Flush() != Connection::IoStatus::OK) {
+      CloseConnection(shard, connection);
+      return;
+    }
+    if (connection->HasPendingOutput()) {
+      if (connection->NeedsStreamData()) {
+        if (io_mode_ != IoMode::SHARDED) {
+          DispatchStreamPull(shard, connection);
+          return;
+        }
+        connection->PullStreamData();
+        continue;
+      }
+      UpdateTimeout(shard, *connection);
+      return; // Wait for EPOLLOUT
+    }
+    if (connection->IsClosing()) {
+      CloseConnection(shard, connection);
+      return;
+    }
+
+    // Same bound as the ring path; bytes left on the socket are read once the batch is answered
+    Connection::IoStatus status = connection->ReadAvailable(parser_limits_.max_header_size + parser_limits_.max_body_size);
+    if (status == Connection::IoStatus::ERROR) {
+      CloseConnection(shard, connection);
+      return;
+    }
+
+    // Everything pipelined so far is answered by one task, in order
+    int error_status = CollectRequests(*connection);
+    if (status == Connection::IoStatus::FULL && connection->Batch().empty() && error_status == 0) {
+      error_status = 413; // No request fits in the input limit (e.g. a long chunked body)
+    }
+
+    if (!connection->Batch().empty() || error_status != 0) {
+      if (status == Connection::IoStatus::CLOSED && connection->Batch().size() < kMaxBatchRequests) {
+        connection->MarkClosing(); // Answer what arrived before the peer's FIN
+      }
+      if (io_mode_ != IoMode::SHARDED) {
+        DispatchBatch(shard, connection, error_status);
+        return;
+      }
+      // Sharded: handle on this core, then flush and look for more input
+      connection->SetBusy(true);
+      UpdateTimeout(shard, *connection);
+      if (!HandleBatch(shard, *connection, error_status, [this, &shard, connection] { HandBack(shard, connection); })) {
+        return; // A coroutine handler resumes on this loop and hands the connection back
+      }
+      connection->SetBusy(false);
+      continue;
+    }
+
+    // Peer is gone before sending a complete request
+    if (status == Connection::IoStatus::CLOSED) {
+      CloseConnection(shard, connection);
+      return;
+    }
+    UpdateTimeout(shard, *connection);
+    return;
+  }
+}
+
+int Server::CollectRequests(Connection& connection) {
+  std::vector<Request>& batch = connection.Batch();
+  while (batch.size() < kMaxBatchRequests) {
+    // Parse straight into the reused batch slot, no Request is copied
+    RequestParser::Result result = connection.NextRequest(batch.emplace_back());
+    if (result == RequestParser::Result::COMPLETE) {
+      continue;
+    }
+    batch.pop_back();
+    return result == RequestParser::Result::ERROR ? connection.ParseErrorStatus() : 0;
+  }
+  return 0;
+}
+
+void Server::DispatchBatch(Shard& shard, Connection* connection, int error_status) {
+  connection->SetBusy(true);
+  UpdateTimeout(shard, *connection);
+
+  auto queued = std::chrono::steady_clock::now();
+  bool accepted = thread_pool_.TryEnqueue([this, &shard, connection, error_status, queued] {
+    auto hand_back = [this, &shard, connection] { HandBack(shard, connection); };
+    if (!admission_.Admit(std::chrono::steady_clock::now() - queued)) {
+      // Waited too long in a standing queue: answering it now would only delay the ones behind
+      ShedBatch(*connection, error_status);
+      hand_back();
+      return;
+    }
+    if (HandleBatch(shard, *connection, error_status, hand_back)) {
+      hand_back();
+    }
+  });
+
+  // Saturated: answer from the loop thread rather than grow the queue
+  if (!accepted) {
+    ShedBatch(*connection, error_status);
+    HandBack(shard, connection);
+  }
+}
+
+void Server::HandBack(Shard& shard, Connection* connection) {
+  // Buffers are only touched on the loop thread
+  shard.loop.Post([this, &shard, connection] {
+    connection->SetBusy(false);
+    if (connection->HasPendingError()) {
+      CloseConnection(shard, connection);
+      return;
+    }
+    ResumeConnection(shard, connection);
+  });
+}
+
+void Server::DispatchStreamPull(Shard& shard, Connection* connection) {
+  connection->SetBusy(true);
+  UpdateTimeout(shard, *connection);
+
+  // The stream may block (database, disk): produce the next piece off the loop thread
+  thread_pool_.Enqueue([this, &shard, connection] {
+    connection->PullStreamData();
+    HandBack(shard, connection);
+  });
+}
+
+bool Server::HandleBatch(Shard& shard, Connection& connection, int error_status, const std::function<void()>& done,
+                         size_t first) {
+  // Responses are built in the connection's arena, recycled once the previous ones are sent
+  if (first == 0 && !connection.HasPendingOutput()) {
+    connection.Memory().Reset();
+  }
+  MemoryResourceScope memory_scope(&connection.Memory());
+
+  std::vector<Request>& batch = connection.Batch();
+  for (size_t i = first; i < batch.size(); i++) {
+    Request& req = batch[i];
+    auto started = metrics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    Task<Response> task;
+    std::optional<Response> res = router_.TryDispatch(req, task);
+    if (!res) {
+      if (!task.Start(shard.executor.get())) {
+        // Suspended: whichever thread finishes the handler answers it and goes on with the batch
+        std::move(task).Then([this, &shard, &connection, error_status, done, i, started](Task<Response> finished) {
+          size_t next = i + 1;
+          {
+            MemoryResourceScope scope(&connection.Memory());
+            Request& request = connection.Batch()[i];
+            Response response = TaskResponse(finished);
+            RecordRequest(request, response, started);
+            if (!QueueResponse(connection, request, std::move(response))) {
+              next = connection.Batch().size();
+            }
+          }
+          if (HandleBatch(shard, connection, error_status, done, next)) {
+            done();
+          }
+        });
+        return false;
+      }
+      res = TaskResponse(task);
+    }
+
+    RecordRequest(req, *res, started);
+    if (!QueueResponse(connection, req, std::move(*res))) {
+      // Requests pipelined behind this one are dropped with the connection
+      break;
+    }
+  }
+
+  FinishBatch(connection, error_status);
+  return true;
+}
+
+void Server::ShedBatch(Connection& connection, int error_status) {
+  if (!connection.HasPendingOutput()) {
+    connection.Memory().Reset();
+  }
+  MemoryResourceScope memory_scope(&connection.Memory());
+
+  for (const Request& req : connection.Batch()) {
+    if (metrics_) {
+      metrics_->RequestShed();
+    }
+    Response res;
+    res.SetStatus(503);
+    res.SetSerialized(OverloadResponse());
+    if (!QueueResponse(connection, req, std::move(res))) {
+      break;
+    }
+  }
+  REVAK_LOG(DEBUG, "Overloaded: answered {} requests with 503", connection.Batch().size());
+
+  FinishBatch(connection, error_status);
+}
+
+void Server::FinishBatch(Connection& connection, int error_status) {
+  // The stream cannot be framed past a malformed request: answer and close
+  if (error_status != 0 && !connection.IsClosing()) {
+    Response res;
+    res.SetStatus(error_status);
+    res.SetBody(std::format("{} {}\n", error_status, res.GetStatusText()));
+    res.SetHeader("Connection", "close");
+    connection.QueueResponse(std::move(res));
+    REVAK_LOG(WARNING, "Rejected malformed request with status {}", error_status);
+    connection.MarkClosing();
+  }
+
+  connection.Batch().clear();
+}
+
+void Server::RefuseConnection(Connection& connection) {
+  if (metrics_) {
+    metrics_->RequestShed();
+  }
+  Response res;
+  res.SetStatus(503);
+  res.SetSerialized(OverloadResponse());
+  res.SetHeader("Connection", "close");
+  std::string out;
+  res.SerializeHead(out);
+  out += res.GetBody();
+
+  // One attempt that never blocks: this runs on the accept thread, which a client
+  // with a full window must not stall while the server sheds load
+  int fd = connection.NativeHandle();
+  ssize_t sent = ::send(fd, out.data(), out.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+  if (sent == static_cast<ssize_t>(out.size())) {
+    // Read what the client already sent, or closing would reset the connection under the 503
+    char discard[4096];
+    while (::recv(fd, discard, sizeof(discard), MSG_DONTWAIT) > 0) {}
+  }
+  connection.MarkClosing();
+}
+
+void Server::RecordRequest(const Request& req, const Response& res, std::chrono::steady_clock::time_point started) {
+  if (metrics_) {
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started);
+    metrics_->RecordRequest(req.RouteId(), res.GetStatusCode(), static_cast<uint64_t>(duration.count()));
+  }
+}
+
+bool Server::QueueResponse(Connection& connection, const Request& req, Response res) {
+  connection.CountRequest();
+
+  // HTTP/1.0 has no chunked encoding: a streamed body ends with the connection
+  bool close_delimited = res.IsStreamed() && req.Version() == "HTTP/1.0";
+  if (close_delimited) {
+    res.SetChunkedEncoding(false);
+  }
+
+  bool keep_alive = running_ && !close_delimited && req.KeepAlive()
+    && res.GetHeader("Connection") != "close"
+    && connection.RequestsServed() < max_keep_alive_requests_;
+
+  if (!keep_alive) {
+    res.SetHeader("Connection", "close");
+  } else if (req.Version() == "HTTP/1.0") {
+    res.SetHeader("Connection", "keep-alive");
+  }
+
+  REVAK_LOG(DEBUG, "Handled {} {} with status {}", req.Method(), req.Path(), res.GetStatusCode());
+  connection.QueueResponse(std::move(res));
+
+  if (!keep_alive) {
+    connection.MarkClosing();
+  }
+  return keep_alive;
+}
+
+std::chrono::milliseconds Server::TimeoutOf(Connection::Wait wait) const {
+  switch (wait) {
+    case Connection::Wait::IDLE: return keep_alive_timeout_;
+    case Connection::Wait::HEADERS: return header_timeout_;
+    case Connection::Wait::BODY: return body_timeout_;
+    case Connection::Wait::OUTPUT: return write_timeout_;
+    case Connection::Wait::NONE: break;
+  }
+  return std::chrono::milliseconds(0);
+}
+
+void Server::UpdateTimeout(Shard& shard, Connection& connection) {
+  Connection::Wait wait = connection.Waiting();
+  Connection::Wait previous = connection.TimedWait();
+  connection.SetTimedWait(wait);
+
+  // A request's header and body deadlines run from the start of the wait, not from the last read
+  if (wait == previous && (wait == Connection::Wait::HEADERS || wait == Connection::Wait::BODY)) {
+    return;
+  }
+  // Left armed while a worker owns the connection: an expiry meanwhile is ignored,
+  // and the next wait only moves the deadline instead of relinking the timer
+  if (wait == Connection::Wait::NONE) {
+    return;
+  }
+
+  std::chrono::milliseconds timeout = TimeoutOf(wait);
+  if (timeout.count() <= 0) {
+    shard.loop.Timers().Cancel(connection.Timeout());
+    return;
+  }
+  shard.loop.Timers().Arm(connection.Timeout(), timeout);
+}
+
+void Server::ExpireConnection(Shard& shard, Connection* connection) {
+  Connection::Wait wait = connection->TimedWait();
+  if (wait == Connection::Wait::NONE) {
+    return;
+  }
+
+  // Tell a slow client why its request is dropped; the connection closes once the 408 is sent
+  if (wait == Connection::Wait::HEADERS || wait == Connection::Wait::BODY) {
+    REVAK_LOG(DEBUG, "Request on connection {} timed out", connection->NativeHandle());
+    connection->QueueResponse(RequestTimeoutResponse());
+    connection->MarkClosing();
+    ResumeConnection(shard, connection);
+    return;
+  }
+
+  REVAK_LOG(DEBUG, "Closing connection {} after its {} timeout", connection->NativeHandle(),
+            wait == Connection::Wait::IDLE ? "keep-alive" : "write");
+  if (io_mode_ == IoMode::IO_URING) {
+    auto it = shard.ring_connections.find(connection->NativeHandle());
+    if (it != shard.ring_connections.end()) {
+      CloseRingConnection(shard, it->second.get());
+    }
+    return;
+  }
+  CloseConnection(shard, connection);
+}
+
+void Server::CloseConnection(Shard& shard, Connection* connection) {
+  int fd = connection->NativeHandle();
+  shard.loop.Remove(fd);
+  shard.loop.Timers().Cancel(connection->Timeout());
+
+  // Freed after the round: events for it fetched in the same batch may still be dispatched
+  auto it = shard.connections.find(fd);
+  if (it != shard.connections.end()) {
+    shard.loop.Retire(std::move(it->second));
+    shard.connections.erase(it);
+  }
+  if (metrics_) {
+    metrics_->ConnectionClosed();
+  }
+}
+
+bool Server::AddRoute(const std::string& method, const std::string& path, Handler handler) {
   return router_.AddRoute(method, path, handler);
 }
 
+bool Server::AddRoute(const std::string& method, const std::string& path, AsyncHandler handler) {
+  return router_.AddRoute(method, path, handler);
+}
+
+bool Server::RemoveRoute(const std::string& method, const std::string& path) {
+  return router_.RemoveRoute(method, path);
+}
+
+bool Server::SetRouteTable(RouteTableView routes) {
+  return router_.SetRouteTable(routes);
+}
+
 bool Server::Get(const std::string& path, Handler handler) {
   return router_.AddRoute("GET", path, handler);
 }
 
+bool Server::Get(const std::string& path, AsyncHandler handler) {
+  return router_.AddRoute("GET", path, handler);
+}
+
+bool Server::Get(const std::string& path, Handler handler, CacheOptions options) {
+  Handler cached = [cache = response_cache_, handler = std::move(handler), options = std::move(options)](const Request& request) {
+    return cache->Serve(request, handler, options);
+  };
+  return router_.AddRoute("GET", path, cached);
+}
+
 bool Server::Post(const std::string& path, Handler handler) {
   return router_.AddRoute("POST", path, handler);
 }
 
+bool Server::Post(const std::string& path, AsyncHandler handler) {
+  return router_.AddRoute("POST", path, handler);
+}
+
 bool Server::Put(const std::string& path, Handler handler) {
   return router_.AddRoute("PUT", path, handler);
 }
 
+bool Server::Put(const std::string& path, AsyncHandler handler) {
+  return router_.AddRoute("PUT", path, handler);
+}
+
 bool Server::Delete(const std::string& path, Handler handler) {
   return router_.AddRoute("DELETE", path, handler);
 }
 
+bool Server::Delete(const std::string& path, AsyncHandler handler) {
+  return router_.AddRoute("DELETE", path, handler);
+}
+
+bool Server::Static(const std::string& prefix, const std::string& root, StaticFileOptions options) {
+  std::string route = prefix;
+  while (!route.empty() && route.back() == '/') {
+    route.pop_back();
+  }
+  route += "/*";
+  route += StaticFiles::kPathParam;
+
+  // Shared by both routes, lives as long as the handlers
+  auto files = std::make_shared<StaticFiles>(root, std::move(options));
+  Handler handler = [files](const Request& request) { return files->Serve(request); };
+  return router_.AddRoute("GET", route, handler) && router_.AddRoute("HEAD", route, handler);
+}
+
+bool Server::EnableMetrics(const std::string& path) {
+  if (metrics_) {
+    Logger::Instance().Log(Logger::Level::WARNING, "Metrics are already enabled");
+    return false;
+  }
+  // Connections and workers read metrics_ without synchronisation, so it is only set before they start
+  if (running_) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Metrics must be enabled before the server runs");
+    return false;
+  }
+
+  // Built before the route is published, so a dispatch of it never sees it missing
+  auto metrics = std::make_unique<Metrics>();
+  if (!router_.AddRoute("GET", path, [this, collector = metrics.get()](const Request&) {
+        Response response;
+        response.SetHeader("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+        response.SetBody(collector->Render(router_, thread_pool_.GetStats()));
+        return response;
+      })) {
+    return false;
+  }
+  metrics_ = std::move(metrics);
+  thread_pool_.SetWaitTiming(true);
+  return true;
+}
+
+void Server::SetKeepAliveTimeout(std::chrono::milliseconds timeout) {
+  keep_alive_timeout_ = timeout;
+}
+
+void Server::SetHeaderTimeout(std::chrono::milliseconds timeout) {
+  header_timeout_ = timeout;
+}
+
+void Server::SetBodyTimeout(std::chrono::milliseconds timeout) {
+  body_timeout_ = timeout;
+}
+
+void Server::SetWriteTimeout(std::chrono::milliseconds timeout) {
+  write_timeout_ = timeout;
+}
+
+void Server::SetMaxKeepAliveRequests(size_t max_requests) {
+  max_keep_alive_requests_ = max_requests;
+}
+
+void Server::SetMaxHeaderSize(size_t max_size) {
+  parser_limits_.max_header_size = max_size;
+}
+
+void Server::SetMaxBodySize(size_t max_size) {
+  parser_limits_.max_body_size = max_size;
+}
+
+void Server::SetMaxQueuedRequests(size_t max_queued) {
+  thread_pool_.SetQueueLimit(max_queued);
+}
+
+void Server::SetQueueDelayTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval) {
+  admission_.SetTarget(target, interval);
+}
+
+void Server::SetResponseCacheSize(size_t max_bytes) {
+  response_cache_->SetMaxBytes(max_bytes);
+}
+
 bool Server::Stop() {
   running_ = false;
-  socket_.Close();
+  for (auto& shard : shards_) {
+    shard->loop.Stop();
+    shard->listener.Close();
+  }
   Logger::Instance().Log(Logger::Level::INFO, "Server stopped.");
   return true;
 }
@@ -11,9 +11,13 @@
 
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/time.h>
 #include <cstring>
+#include <cerrno>
 
 namespace revak {
 
@@ -36,11 +40,9 @@ Socket::Socket() {
 	}
 }
 
-Socket::Socket(int fd) : fd_(fd) {
-	if (fd_ < 0) {
-		Logger::Instance().Log(Logger::Level::ERROR, "Invalid file descriptor provided to Socket wrapper");
-	}
-}
+// Accept() and FromNativeHandle() report their own failures, so an
+// invalid fd (e.g. EAGAIN on a non-blocking listener) is not logged here
+Socket::Socket(int fd) : fd_(fd) {}
 
 Socket::~Socket() {
 	Close();
@@ -59,6 +61,15 @@ Socket& Socket::operator=(Socket&& other) noexcept {
 	return *this;
 }
 
+bool Socket::SetReusePort() {
+  int opt = 1;
+  if (::setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to set SO_REUSEPORT option: " + std::string(std::strerror(errno)));
+    return false;
+  }
+  return true;
+}
+
 bool Socket::Bind(uint16_t port) {
 	struct sockaddr_in addr{};
 	std::memset(&addr, 0, sizeof(addr));
@@ -84,6 +95,35 @@ bool Socket::Listen() {
 	return true;
 }
 
+bool Socket::Connect(const std::string& host, uint16_t port) {
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  int error = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result);
+  if (error != 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to resolve " + host + ": " + ::gai_strerror(error));
+    return false;
+  }
+
+  int status = ::connect(fd_, result->ai_addr, result->ai_addrlen);
+  ::freeaddrinfo(result);
+  if (status < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to connect to " + host + ":" + std::to_string(port) + ": " + std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool Socket::SetNoDelay() {
+  int opt = 1;
+  if (::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt)) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to set TCP_NODELAY option: " + std::string(std::strerror(errno)));
+    return false;
+  }
+  return true;
+}
+
 Socket Socket::Accept() {
 	struct sockaddr_in client_addr{};
 	socklen_t client_len = sizeof(client_addr);
@@ -93,7 +133,10 @@ Socket Socket::Accept() {
 	int client_fd = ::accept(fd_, (struct sockaddr*)&client_addr, &client_len);
 
 	if (client_fd < 0) {
-		Logger::Instance().Log(Logger::Level::ERROR, "Failed to accept incoming connection");
+		// A non-blocking listener reports an empty backlog with EAGAIN, which is not an error
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			Logger::Instance().Log(Logger::Level::ERROR, "Failed to accept incoming connection");
+		}
 		return Socket(-1); // Return invalid Socket
 	}
 
@@ -117,6 +160,30 @@ bool Socket::SetNonBlocking() {
   return true;
 }
 
+bool Socket::SetReceiveTimeout(std::chrono::milliseconds timeout) {
+  struct timeval tv{};
+  tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+  tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+
+  if (::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to set receive timeout: " + std::string(std::strerror(errno)));
+    return false;
+  }
+  return true;
+}
+
+bool Socket::SetSendTimeout(std::chrono::milliseconds timeout) {
+  struct timeval tv{};
+  tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+  tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+
+  if (::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to set send timeout: " + std::string(std::strerror(errno)));
+    return false;
+  }
+  return true;
+}
+
 bool Socket::Close() {
 	if (fd_ != -1) {
 		::shutdown(fd_, SHUT_RDWR); // syscall
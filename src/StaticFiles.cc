@@ -0,0 +1,437 @@
+/**
+ * @file StaticFiles.cc
+ * @brief StaticFiles class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/StaticFiles.h"
+#include "revak/DateCache.h"
+#include "revak/Logger.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <format>
+#include <mutex>
+#include <optional>
+
+namespace revak {
+
+namespace {
+
+/** Content types by file extension */
+constexpr std::pair<std::string_view, std::string_view> kContentTypes[] = {
+  {"html", "text/html; charset=utf-8"},
+  {"htm", "text/html; charset=utf-8"},
+  {"css", "text/css; charset=utf-8"},
+  {"js", "text/javascript; charset=utf-8"},
+  {"mjs", "text/javascript; charset=utf-8"},
+  {"json", "application/json"},
+  {"map", "application/json"},
+  {"txt", "text/plain; charset=utf-8"},
+  {"xml", "application/xml"},
+  {"svg", "image/svg+xml"},
+  {"png", "image/png"},
+  {"jpg", "image/jpeg"},
+  {"jpeg", "image/jpeg"},
+  {"gif", "image/gif"},
+  {"webp", "image/webp"},
+  {"avif", "image/avif"},
+  {"ico", "image/x-icon"},
+  {"woff", "font/woff"},
+  {"woff2", "font/woff2"},
+  {"ttf", "font/ttf"},
+  {"wasm", "application/wasm"},
+  {"pdf", "application/pdf"},
+  {"mp4", "video/mp4"},
+  {"webm", "video/webm"},
+  {"mp3", "audio/mpeg"},
+};
+
+std::string_view ContentType(std::string_view path) {
+  size_t slash = path.rfind('/');
+  size_t dot = path.rfind('.');
+  if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash)) {
+    return "application/octet-stream";
+  }
+  std::string_view extension = path.substr(dot + 1);
+  for (const auto& [known, type] : kContentTypes) {
+    if (known.size() == extension.size() &&
+        std::equal(known.begin(), known.end(), extension.begin(),
+                   [](char a, char b) { return a == (b >= 'A' && b <= 'Z' ? b + ('a' - 'A') : b); })) {
+      return type;
+    }
+  }
+  return "application/octet-stream";
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @brief Percent-decode a URL path and check it stays below the root
+ * @return Relative filesystem path, std::nullopt if malformed or escaping the root
+ */
+std::optional<std::string> DecodePath(std::string_view raw) {
+  std::string path;
+  path.reserve(raw.size());
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '%') {
+      path += raw[i];
+      continue;
+    }
+    if (i + 2 >= raw.size() || HexValue(raw[i + 1]) < 0 || HexValue(raw[i + 2]) < 0) {
+      return std::nullopt;
+    }
+    path += static_cast<char>(HexValue(raw[i + 1]) * 16 + HexValue(raw[i + 2]));
+    i += 2;
+  }
+
+  // No NUL bytes, no ".." segments (encoded ones included, hence after decoding)
+  if (path.find('\0') != std::string::npos) {
+    return std::nullopt;
+  }
+  size_t start = 0;
+  while (start <= path.size()) {
+    size_t end = std::min(path.find('/', start), path.size());
+    if (path.compare(start, end - start, "..") == 0) {
+      return std::nullopt;
+    }
+    start = end + 1;
+  }
+  return path;
+}
+
+/** Parse an IMF-fixdate, std::nullopt if it is not one */
+std::optional<int64_t> ParseHttpDate(std::string_view value) {
+  std::string text(value);
+  std::tm tm{};
+  const char* end = ::strptime(text.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+  if (end == nullptr || *end != '\0') {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(::timegm(&tm));
+}
+
+/** A satisfiable byte range */
+struct ByteRange {
+  uint64_t first;
+  uint64_t length;
+};
+
+enum class RangeResult { NONE, SATISFIABLE, UNSATISFIABLE };
+
+/**
+ * @brief Parse a single "bytes=" range against a file size
+ *
+ * Multiple ranges are answered with the whole file, which RFC 9110 allows.
+ */
+RangeResult ParseRange(std::string_view value, uint64_t size, ByteRange& range) {
+  if (!value.starts_with("bytes=")) {
+    return RangeResult::NONE;
+  }
+  value.remove_prefix(6);
+  if (value.find(',') != std::string_view::npos) {
+    return RangeResult::NONE;
+  }
+  size_t dash = value.find('-');
+  if (dash == std::string_view::npos) {
+    return RangeResult::NONE;
+  }
+  std::string_view first_text = value.substr(0, dash);
+  std::string_view last_text = value.substr(dash + 1);
+
+  auto parse = [](std::string_view text, uint64_t& number) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), number);
+    return ec == std::errc() && ptr == text.data() + text.size();
+  };
+
+  uint64_t first = 0;
+  uint64_t last = 0;
+  if (first_text.empty()) {
+    // Suffix range: the last N bytes
+    if (!parse(last_text, last)) {
+      return RangeResult::NONE;
+    }
+    if (last == 0 || size == 0) {
+      return RangeResult::UNSATISFIABLE;
+    }
+    range.length = std::min(last, size);
+    range.first = size - range.length;
+    return RangeResult::SATISFIABLE;
+  }
+
+  if (!parse(first_text, first)) {
+    return RangeResult::NONE;
+  }
+  if (last_text.empty()) {
+    last = size == 0 ? 0 : size - 1;
+  } else if (!parse(last_text, last) || last < first) {
+    return RangeResult::NONE;
+  }
+  if (first >= size) {
+    return RangeResult::UNSATISFIABLE;
+  }
+  last = std::min(last, size - 1);
+  range.first = first;
+  range.length = last - first + 1;
+  return RangeResult::SATISFIABLE;
+}
+
+int64_t NowMillis() {
+  timespec ts{};
+  ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+Response ErrorResponse(int status) {
+  Response response;
+  response.SetStatus(status);
+  response.SetBody(std::format("{} {}\n", status, response.GetStatusText()));
+  return response;
+}
+
+} // namespace
+
+struct StaticFiles::FileEntry {
+  /** File size in bytes */
+  uint64_t size{0};
+
+  /** Modification time, seconds since the epoch */
+  int64_t mtime{0};
+
+  /** Modification time, nanosecond part (part of the change check) */
+  int64_t mtime_nsec{0};
+
+  /** Precomputed header values */
+  std::string etag;
+  std::string last_modified;
+  std::string_view content_type;
+
+  /** Contents of a cached file, null for a file sent with sendfile */
+  std::shared_ptr<const std::string> content;
+
+  /** Open file of an uncached file */
+  std::shared_ptr<const FileHandle> file;
+
+  /** Last time the entry was checked against the disk (monotonic milliseconds) */
+  mutable std::atomic<int64_t> checked_at{0};
+};
+
+StaticFiles::StaticFiles(std::string root, StaticFileOptions options)
+  : root_(std::move(root)), options_(std::move(options)) {
+  while (root_.size() > 1 && root_.back() == '/') {
+    root_.pop_back();
+  }
+}
+
+Response StaticFiles::Serve(const Request& request) {
+  std::optional<std::string> relative = DecodePath(request.Param(kPathParam));
+  if (!relative) {
+    return ErrorResponse(404);
+  }
+
+  std::string path = root_ + "/" + *relative;
+  bool trailing_slash = path.back() == '/';
+  if (trailing_slash) {
+    path += options_.index_file;
+  }
+
+  int status = 0;
+  bool is_directory = false;
+  std::shared_ptr<const FileEntry> entry = Lookup(path, status, is_directory);
+  if (!entry && is_directory && !trailing_slash) {
+    // Relative links in the index resolve against the directory only with a trailing slash
+    std::string_view target = request.Path();
+    size_t query = std::min(target.find('?'), target.size());
+    Response response;
+    response.SetStatus(301);
+    response.SetHeader("Location", std::format("{}/{}", target.substr(0, query), target.substr(query)));
+    return response;
+  }
+  if (!entry) {
+    return ErrorResponse(is_directory ? 404 : status);
+  }
+  return Respond(request, *entry);
+}
+
+std::shared_ptr<const StaticFiles::FileEntry> StaticFiles::Lookup(const std::string& path, int& status, bool& is_directory) {
+  std::shared_ptr<const FileEntry> cached;
+  {
+    std::lock_guard lock(cache_mutex_);
+    auto it = cache_.find(path);
+    if (it != cache_.end()) {
+      cache_lru_.splice(cache_lru_.begin(), cache_lru_, it->second);
+      cached = it->second->second;
+    }
+  }
+
+  if (cached) {
+    int64_t now = NowMillis();
+    if (now - cached->checked_at.load(std::memory_order_relaxed) < options_.revalidate_interval.count()) {
+      return cached;
+    }
+    // Trust the cached copy again if the file did not change
+    struct stat info{};
+    if (::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode) &&
+        static_cast<uint64_t>(info.st_size) == cached->size &&
+        info.st_mtim.tv_sec == cached->mtime && info.st_mtim.tv_nsec == cached->mtime_nsec) {
+      cached->checked_at.store(now, std::memory_order_relaxed);
+      return cached;
+    }
+    std::lock_guard lock(cache_mutex_);
+    auto it = cache_.find(path);
+    if (it != cache_.end() && it->second->second == cached) {
+      Evict(it->second);
+    }
+  }
+  return Load(path, status, is_directory);
+}
+
+std::shared_ptr<const StaticFiles::FileEntry> StaticFiles::Load(const std::string& path, int& status, bool& is_directory) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    status = errno == EACCES ? 403 : (errno == ENOENT || errno == ENOTDIR ? 404 : 500);
+    return nullptr;
+  }
+  auto file = std::make_shared<const FileHandle>(fd);
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    status = 500;
+    return nullptr;
+  }
+  if (S_ISDIR(info.st_mode)) {
+    is_directory = true;
+    return nullptr;
+  }
+  if (!S_ISREG(info.st_mode)) {
+    status = 404;
+    return nullptr;
+  }
+
+  auto entry = std::make_shared<FileEntry>();
+  entry->size = static_cast<uint64_t>(info.st_size);
+  entry->mtime = static_cast<int64_t>(info.st_mtim.tv_sec);
+  entry->mtime_nsec = static_cast<int64_t>(info.st_mtim.tv_nsec);
+  entry->etag = std::format("\"{:x}-{:x}\"", entry->mtime, entry->size);
+  char date[DateCache::kDateLength];
+  DateCache::Format(entry->mtime, date);
+  entry->last_modified.assign(date, DateCache::kDateLength);
+  entry->content_type = ContentType(path);
+  entry->checked_at.store(NowMillis(), std::memory_order_relaxed);
+
+  if (entry->size > options_.max_cached_file_size) {
+    entry->file = std::move(file);
+    return entry;
+  }
+
+  // Small file: read it once and keep it in memory
+  auto content = std::make_shared<std::string>(entry->size, '\0');
+  size_t done = 0;
+  while (done < content->size()) {
+    ssize_t n = ::pread(fd, content->data() + done, content->size() - done, static_cast<off_t>(done));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      status = 500;
+      Logger::Instance().Log(Logger::Level::ERROR, "Failed to read static file: " + path);
+      return nullptr;
+    }
+    done += static_cast<size_t>(n);
+  }
+  entry->content = std::move(content);
+
+  if (entry->size > options_.max_cache_bytes) {
+    return entry;
+  }
+  std::lock_guard lock(cache_mutex_);
+  if (auto it = cache_.find(path); it != cache_.end()) {
+    Evict(it->second);
+  }
+  cache_lru_.emplace_front(path, entry);
+  cache_.emplace(cache_lru_.front().first, cache_lru_.begin());
+  cached_bytes_ += entry->size;
+  while (cached_bytes_ > options_.max_cache_bytes) {
+    Evict(std::prev(cache_lru_.end()));
+  }
+  return entry;
+}
+
+void StaticFiles::Evict(CacheList::iterator position) {
+  cached_bytes_ -= position->second->size;
+  cache_.erase(position->first);
+  cache_lru_.erase(position);
+}
+
+Response StaticFiles::Respond(const Request& request, const FileEntry& entry) const {
+  Response response;
+  response.SetHeader("ETag", entry.etag);
+  response.SetHeader("Last-Modified", entry.last_modified);
+
+  // If-None-Match takes precedence over If-Modified-Since (RFC 9110 13.2.2)
+  bool not_modified = false;
+  if (!request.Header(HttpHeader::IF_NONE_MATCH).empty()) {
+    not_modified = request.MatchesEtag(entry.etag);
+  } else if (std::string_view since = request.Header(HttpHeader::IF_MODIFIED_SINCE); !since.empty()) {
+    std::optional<int64_t> date = ParseHttpDate(since);
+    not_modified = date && entry.mtime <= *date;
+  }
+  if (not_modified) {
+    response.SetStatus(304);
+    return response;
+  }
+
+  response.SetHeader("Content-Type", entry.content_type);
+  response.SetHeader("Accept-Ranges", "bytes");
+
+  ByteRange range{0, entry.size};
+  std::string_view range_header = request.Header(HttpHeader::RANGE);
+  std::string_view if_range = request.Header(HttpHeader::IF_RANGE);
+  bool range_applies = !range_header.empty() && request.MethodId() == HttpMethod::GET &&
+    (if_range.empty() || if_range == entry.etag || if_range == entry.last_modified);
+
+  if (range_applies) {
+    switch (ParseRange(range_header, entry.size, range)) {
+      case RangeResult::NONE:
+        range = {0, entry.size};
+        break;
+      case RangeResult::SATISFIABLE:
+        response.SetStatus(206);
+        response.SetHeader("Content-Range", std::format("bytes {}-{}/{}", range.first, range.first + range.length - 1, entry.size));
+        break;
+      case RangeResult::UNSATISFIABLE:
+        response.SetStatus(416);
+        response.SetHeader("Content-Range", std::format("bytes */{}", entry.size));
+        return response;
+    }
+  }
+
+  if (request.MethodId() == HttpMethod::HEAD) {
+    // Same headers as GET, no body
+    response.SetHeader("Content-Length", std::to_string(range.length));
+    return response;
+  }
+
+  if (entry.content) {
+    response.SetSharedBody(entry.content, static_cast<size_t>(range.first), static_cast<size_t>(range.length));
+  } else {
+    response.SetFileBody({entry.file, range.first, static_cast<size_t>(range.length)});
+  }
+  return response;
+}
+
+} // namespace revak
@@ -1,55 +1,66 @@
 /**
  * @file ThreadPool.cc
  * @brief ThreadPool class implementation
- * 
+ *
  * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
  * Licensed under the MIT License. Part of the Revak project.
  */
 
 #include <revak/ThreadPool.h>
 
-#include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <optional>
 
 namespace revak {
 
-ThreadPool::ThreadPool(size_t numThreads) : stop_(false) {
-  for (size_t i = 0; i < numThreads; i++) {
-    workers_.emplace_back([this] {
-      while(true) {
-      std::function<void()> task;
-      {
-        // Lock the queue mutex
-        std::unique_lock<std::mutex> lock(this->queue_mutex_);
-
-        // Wait until there is a task or the pool is stopped. Don't use CPU
-        this->condition_.wait(lock, [this] {
-          return this->stop_ || !this->tasks_.empty();
-        });
-
-        // If stopping and no tasks left, exit the loop
-        if (this->stop_ && this->tasks_.empty()) {
-          return;
-        }
+namespace {
 
-        // Get the next task from the queue
-        task = std::move(this->tasks_.front());
-        this->tasks_.pop();
-      } // Scope for lock ends here
+/** Pool and worker index of the calling thread, null outside any pool */
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
 
-      task();
-      }
-    });
+/** Hint to the CPU that we are in a spin loop */
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+/** Monotonic time in nanoseconds */
+inline int64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** xorshift32, good enough to spread steal attempts */
+inline uint32_t NextRandom(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t numThreads) : injection_(kInjectionCapacity) {
+  for (size_t i = 0; i < numThreads; i++) {
+    states_.push_back(std::make_unique<Worker>());
+    states_.back()->rng = static_cast<uint32_t>(i * 2654435761u + 1);
+  }
+  // Start the threads only once every deque exists, since workers steal from all of them
+  for (size_t i = 0; i < numThreads; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
   }
 }
 
 ThreadPool::~ThreadPool() {
-  {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    stop_ = true;
-  }
-  condition_.notify_all();
+  stop_.store(true, std::memory_order_seq_cst);
+  wake_epoch_.fetch_add(1, std::memory_order_seq_cst);
+  wake_epoch_.notify_all();
 
   for (std::thread &w : workers_) {
     if (w.joinable()) {
@@ -59,11 +70,153 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::Enqueue(std::function<void()> task) {
-  {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    tasks_.push(std::move(task));
+  Push(std::move(task), true);
+}
+
+bool ThreadPool::TryEnqueue(std::function<void()> task) {
+  if (QueuedApprox() >= queue_limit_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  return Push(std::move(task), false);
+}
+
+void ThreadPool::SetQueueLimit(size_t limit) {
+  queue_limit_.store(limit, std::memory_order_relaxed);
+}
+
+bool ThreadPool::Push(std::function<void()> task, bool wait) {
+  auto* item = new Task{std::move(task), time_waits_.load(std::memory_order_relaxed) ? NowNanoseconds() : 0};
+
+  if (current_pool == this) {
+    // A worker enqueueing follow-up work keeps it local; others will steal if idle
+    states_[current_worker]->deque.Push(item);
+  } else {
+    while (!injection_.TryPush(item)) {
+      if (!wait) {
+        delete item;
+        return false;
+      }
+      // Injection queue full: make sure someone is draining it and back off
+      WakeOne();
+      std::this_thread::yield();
+    }
+  }
+  WakeOne();
+  return true;
+}
+
+void ThreadPool::SetWaitTiming(bool enabled) {
+  time_waits_.store(enabled, std::memory_order_relaxed);
+}
+
+ThreadPool::Stats ThreadPool::GetStats() const {
+  Stats stats;
+  stats.threads = states_.size();
+  stats.queued = QueuedApprox();
+  for (const auto& state : states_) {
+    stats.executed += state->executed.load(std::memory_order_relaxed);
+    state->wait.AddTo(stats.wait);
+  }
+  return stats;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+  current_pool = this;
+  current_worker = index;
+
+  while (true) {
+    Task* task = nullptr;
+    for (int round = 0; round < kSpinRounds && task == nullptr; ++round) {
+      task = FindTask(index);
+      if (task == nullptr) {
+        // Pause first; then give the core away in case producers share it
+        if (round < kPauseRounds) {
+          CpuRelax();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    if (task != nullptr) {
+      std::unique_ptr<Task> owned(task);
+      Worker& self = *states_[index];
+      if (owned->enqueued_ns != 0) {
+        self.wait.Record(static_cast<uint64_t>(std::max<int64_t>(0, NowNanoseconds() - owned->enqueued_ns)));
+      }
+      self.executed.store(self.executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      owned->function();
+      continue;
+    }
+
+    // If stopping and no tasks left, exit the loop
+    if (stop_.load(std::memory_order_acquire) && !HasWork()) {
+      return;
+    }
+
+    // Park. Announce ourselves before the final check so a producer that
+    // pushes after it is guaranteed to see us and bump the epoch.
+    uint32_t epoch = wake_epoch_.load(std::memory_order_seq_cst);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    if (!HasWork() && !stop_.load(std::memory_order_seq_cst)) {
+      wake_epoch_.wait(epoch, std::memory_order_seq_cst);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+ThreadPool::Task* ThreadPool::FindTask(size_t index) {
+  Worker& self = *states_[index];
+  if (Task* task = self.deque.Take()) {
+    return task;
+  }
+  if (std::optional<Task*> task = injection_.TryPop()) {
+    return *task;
+  }
+
+  const size_t count = states_.size();
+  const size_t start = NextRandom(self.rng) % count;
+  for (size_t i = 0; i < count; ++i) {
+    size_t victim = (start + i) % count;
+    if (victim == index) {
+      continue;
+    }
+    if (Task* task = states_[victim]->deque.Steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+size_t ThreadPool::QueuedApprox() const {
+  size_t queued = injection_.SizeApprox();
+  for (const auto& state : states_) {
+    queued += state->deque.SizeApprox();
+  }
+  return queued;
+}
+
+bool ThreadPool::HasWork() const {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (injection_.SizeApprox() > 0) {
+    return true;
+  }
+  for (const auto& state : states_) {
+    if (!state->deque.Empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WakeOne() {
+  // Pairs with the sleepers_ increment in WorkerLoop: either the worker's
+  // final check sees our push, or we see the worker and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleepers_.load(std::memory_order_relaxed) > 0) {
+    wake_epoch_.fetch_add(1, std::memory_order_seq_cst);
+    wake_epoch_.notify_one();
   }
-  condition_.notify_one();
 }
 
-} // namespace revak
\ No newline at end of file
+} // namespace revak
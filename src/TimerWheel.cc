@@ -0,0 +1,232 @@
+/**
+ * @file TimerWheel.cc
+ * @brief TimerWheel class implementation
+ *
+ * Copyright (c) 2025 Hüseyin Karakaya (https://github.com/karakayahuseyin)
+ * Licensed under the MIT License. Part of the Revak project.
+ */
+
+#include "revak/TimerWheel.h"
+#include "revak/Logger.h"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+namespace revak {
+
+namespace {
+
+/** Length of a tick in nanoseconds */
+constexpr int64_t kTickNs = std::chrono::duration_cast<std::chrono::nanoseconds>(TimerWheel::kTick).count();
+
+constexpr int64_t kNsPerSecond = 1'000'000'000;
+
+/** CLOCK_MONOTONIC, the clock the timerfd counts in, in nanoseconds */
+int64_t MonotonicNs() {
+  timespec ts{};
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * kNsPerSecond + ts.tv_nsec;
+}
+
+} // namespace
+
+TimerWheel::Timer::~Timer() {
+  if (wheel_ != nullptr) {
+    wheel_->Cancel(*this);
+  }
+}
+
+TimerWheel::TimerWheel() : origin_ns_(MonotonicNs()) {
+  timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd_ < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to create timerfd: " + std::string(std::strerror(errno)));
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  for (Timer*& head : slots_) {
+    while (Timer* timer = head) {
+      Unlink(*timer);
+      timer->wheel_ = nullptr;
+      if (timer->owned_) {
+        delete timer;
+      }
+    }
+  }
+  if (timer_fd_ >= 0) ::close(timer_fd_);
+}
+
+void TimerWheel::Arm(Timer& timer, std::chrono::milliseconds delay) {
+  // Rounded up so the timer never fires early, and never into a slot the hand already passed
+  int64_t delay_ns = std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count(), 0);
+  auto deadline = static_cast<uint64_t>((MonotonicNs() - origin_ns_ + delay_ns + kTickNs - 1) / kTickNs);
+  deadline = std::max(deadline, current_ + 1);
+
+  if (timer.wheel_ == this) {
+    if (deadline >= timer.deadline_) {
+      // Later: the timer moves when its current slot comes round
+      timer.deadline_ = deadline;
+      return;
+    }
+    Cancel(timer);
+  } else if (timer.wheel_ != nullptr) {
+    timer.wheel_->Cancel(timer);
+  }
+
+  timer.deadline_ = deadline;
+  Insert(timer);
+  if (deadline < scheduled_ && !expiring_) {
+    Schedule(deadline);
+  }
+}
+
+void TimerWheel::Cancel(Timer& timer) {
+  if (timer.wheel_ != this) {
+    return;
+  }
+  Unlink(timer);
+  timer.wheel_ = nullptr;
+  if (slots_[timer.slot_] == nullptr) {
+    occupied_[timer.slot_ / 64] &= ~(uint64_t{1} << (timer.slot_ % 64));
+  }
+}
+
+bool TimerWheel::RunAfter(std::chrono::milliseconds delay, std::function<void()> task) {
+  if (timer_fd_ < 0) {
+    return false;
+  }
+  // Owned by the wheel, which deletes it once it ran
+  auto timer = std::make_unique<Timer>(std::move(task));
+  timer->owned_ = true;
+  Arm(*timer, delay);
+  timer.release();
+  return true;
+}
+
+void TimerWheel::Expire() {
+  uint64_t expirations;
+  while (::read(timer_fd_, &expirations, sizeof(expirations)) > 0) {}
+  scheduled_ = kNever;
+
+  uint64_t now = NowTick();
+  if (now > current_) {
+    // One revolution visits every slot, going further would only visit them again
+    uint64_t first = std::max(current_ + 1, now - std::min<uint64_t>(now, kSlots - 1));
+    current_ = now; // Timers armed by the callbacks go after now
+
+    expiring_ = true;
+    for (uint64_t tick = first; tick <= now; ++tick) {
+      size_t slot = tick % kSlots;
+      if (occupied_[slot / 64] & (uint64_t{1} << (slot % 64))) {
+        ExpireSlot(slot, now);
+      }
+    }
+    expiring_ = false;
+  }
+  ScheduleNext();
+}
+
+uint64_t TimerWheel::NowTick() const {
+  return static_cast<uint64_t>((MonotonicNs() - origin_ns_) / kTickNs);
+}
+
+void TimerWheel::Push(Timer*& head, Timer& timer) {
+  timer.next_ = head;
+  if (head != nullptr) {
+    head->link_ = &timer.next_;
+  }
+  head = &timer;
+  timer.link_ = &head;
+}
+
+void TimerWheel::Unlink(Timer& timer) {
+  *timer.link_ = timer.next_;
+  if (timer.next_ != nullptr) {
+    timer.next_->link_ = timer.link_;
+  }
+  timer.next_ = nullptr;
+  timer.link_ = nullptr;
+}
+
+void TimerWheel::Insert(Timer& timer) {
+  size_t slot = timer.deadline_ % kSlots;
+  timer.wheel_ = this;
+  timer.slot_ = slot;
+  Push(slots_[slot], timer);
+  occupied_[slot / 64] |= uint64_t{1} << (slot % 64);
+}
+
+void TimerWheel::ExpireSlot(size_t slot, uint64_t now) {
+  // Timers re-armed later or due in a later revolution wait aside, so each is looked at once
+  Timer* later = nullptr;
+  while (Timer* timer = slots_[slot]) {
+    Unlink(*timer);
+    if (timer->deadline_ > now) {
+      Push(later, *timer);
+      continue;
+    }
+    timer->wheel_ = nullptr;
+    if (timer->owned_) {
+      std::function<void()> task = std::move(timer->callback_);
+      delete timer;
+      task();
+    } else {
+      // Copied: the callback may destroy the timer along with its owner
+      std::function<void()> callback = timer->callback_;
+      callback();
+    }
+  }
+  occupied_[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+  while (Timer* timer = later) {
+    Unlink(*timer);
+    Insert(*timer);
+  }
+}
+
+void TimerWheel::ScheduleNext() {
+  // First occupied slot after the hand, a word of the bitmap at a time
+  size_t step = 0;
+  while (step < kSlots) {
+    size_t slot = (current_ + 1 + step) % kSlots;
+    uint64_t bits = occupied_[slot / 64] >> (slot % 64);
+    if (bits != 0) {
+      step += static_cast<size_t>(std::countr_zero(bits));
+      if (step < kSlots) {
+        Schedule(current_ + 1 + step);
+        return;
+      }
+      break;
+    }
+    step += 64 - slot % 64;
+  }
+
+  if (scheduled_ != kNever) {
+    itimerspec disarm{};
+    ::timerfd_settime(timer_fd_, 0, &disarm, nullptr);
+    scheduled_ = kNever;
+  }
+}
+
+void TimerWheel::Schedule(uint64_t tick) {
+  if (tick == scheduled_) {
+    return;
+  }
+  int64_t at = origin_ns_ + static_cast<int64_t>(tick) * kTickNs;
+  itimerspec spec{};
+  spec.it_value.tv_sec = at / kNsPerSecond;
+  spec.it_value.tv_nsec = at % kNsPerSecond;
+  if (::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+    Logger::Instance().Log(Logger::Level::ERROR, "Failed to arm timerfd: " + std::string(std::strerror(errno)));
+    return;
+  }
+  scheduled_ = tick;
+}
+
+} // namespace revak